@@ -114,6 +114,10 @@ static const char helpstr[] =
    "  -D, --define=arg             sets the value of a parse define\n"
    "  -e, --exec=arg               execute program given on command-line\n"
    "  -g, --disable-gc             disable the garbage collector\n"
+   "      --background-gc          make recursive reference scans in a background\n"
+   "                               thread\n"
+   "      --background-thread-pool reuse native threads for the background\n"
+   "                               operator\n"
    "  -h, --help                   shows this help text and exit\n"
    "  -i, --list-warnings          list all warnings and quit\n"
    "  -l, --load=arg               load module 'arg' immediately\n"
@@ -572,6 +576,14 @@ static void disable_gc(const char* arg) {
    qore_lib_options |= QLO_DISABLE_GARBAGE_COLLECTION;
 }
 
+static void background_gc(const char* arg) {
+   qore_lib_options |= QLO_BACKGROUND_GARBAGE_COLLECTION;
+}
+
+static void background_thread_pool(const char* arg) {
+   qore_lib_options |= QLO_BACKGROUND_THREAD_POOL;
+}
+
 static void show_module_errors(const char* arg) {
    show_mod_errs = true;
 }
@@ -606,6 +618,8 @@ static struct opt_struct_s {
    { 'c', "charset",               ARG_MAND, set_charset },
    { 'e', "exec",                  ARG_MAND, set_exec },
    { 'g', "disable-gc",            ARG_NONE, disable_gc },
+   { '\0', "background-gc",        ARG_NONE, background_gc },
+   { '\0', "background-thread-pool", ARG_NONE, background_thread_pool },
    { 'h', "help",                  ARG_NONE, do_help },
    { 'i', "list-warnings",         ARG_NONE, list_warnings },
    { 'l', "load",                  ARG_MAND, load_module },
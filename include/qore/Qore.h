@@ -185,6 +185,8 @@ DLLEXPORT extern const QoreStringMaker mpfrInfo;
 #define QLO_DO_NOT_SEED_RNG            (1 << 4)  //!< disable seeding the random number generator when the Qore library is initialized
 #define QLO_DISABLE_TLS_13             (1 << 5)  //!< disable TLS v1.3 (may be set at runtime with qore_set_library_options())
 #define QLO_MINIMUM_TLS_13             (1 << 6)  //!< minimum TLS v1.3; overrides QLO_DISABLE_TLS_13 (may be set at runtime with qore_set_library_options())
+#define QLO_BACKGROUND_GARBAGE_COLLECTION (1 << 7)  //!< make recursive object reference scans in a background thread
+#define QLO_BACKGROUND_THREAD_POOL     (1 << 8)  //!< reuse native threads for the background operator
 
 #define QLO_RUNTIME_OPTS (QLO_DISABLE_TLS_13)
 
@@ -394,6 +394,9 @@ public:
 
     //! tries to grab the read lock; does not block if unsuccessful; returns 0 if successful
     DLLLOCAL int tryrdlock();
+
+    //! returns the write sequence counter for optimistic lock-free reads; odd while a writer holds the lock
+    DLLLOCAL unsigned getWriteSeq() const;
 };
 
 #endif
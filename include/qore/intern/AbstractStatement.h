@@ -49,6 +49,13 @@
 #define PF_CONTINUE_OK           (1 << 7)
 #define PF_NO_TOP_LEVEL_LVARS    (1 << 8)
 
+// opcodes for statements in statement blocks executed with pre-decoded instructions
+enum qore_stmt_op_e : unsigned char {
+    QSOP_EXEC = 0,          // executes the statement with AbstractStatement::exec()
+    QSOP_EXPRESSION = 1,    // evaluates an expression and discards the result
+    QSOP_RETURN = 2,        // evaluates an expression as the return value of the current function
+};
+
 // all definitions in this file are private to the library and subject to change
 // forward references
 class LVList;
@@ -101,6 +108,12 @@ public:
 
     DLLLOCAL virtual void parseCommit(QoreProgram* pgm);
 
+    // returns the opcode used to execute the statement from a pre-decoded statement block; statements with an
+    // expression opcode return the expression in the argument
+    DLLLOCAL virtual qore_stmt_op_e getExecOp(QoreValue& exp) const {
+        return QSOP_EXEC;
+    }
+
 protected:
     QoreBreakpointList_t* breakpoints = nullptr;
     volatile bool breakpointFlag = false;  // fast access to check if breakpoints are non-empty
@@ -0,0 +1,141 @@
+/* -*- mode: c++; indent-tabs-mode: nil -*- */
+/*
+  DistributedReaderRWLock.h
+
+  RWLock with read lock state kept in per-thread slots
+
+  Qore Programming Language
+
+  Copyright (C) 2003 - 2024 Qore Technologies, s.r.o.
+
+  Permission is hereby granted, free of charge, to any person obtaining a
+  copy of this software and associated documentation files (the "Software"),
+  to deal in the Software without restriction, including without limitation
+  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+  and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+  DEALINGS IN THE SOFTWARE.
+
+  Note that the Qore library is released under a choice of three open-source
+  licenses: MIT (as above), LGPL 2+, or GPL 2+; see README-LICENSE for more
+  information.
+*/
+
+#ifndef _QORE_INTERN_DISTRIBUTEDREADERRWLOCK_H
+#define _QORE_INTERN_DISTRIBUTEDREADERRWLOCK_H
+
+#include "qore/RWLock.h"
+#include "qore/intern/QoreDistributedRWLock.h"
+
+#include <atomic>
+#include <typeinfo>
+
+//! an RWLock that keeps its read lock state in per-thread slots, each with its own lock and TID maps
+/** Readers only acquire the lock of their slot unless a writer holds or is waiting for the write lock, in which case
+    they wait with the asl_lock held; writers have priority over new readers, but the read lock can still be acquired
+    recursively by a thread that already holds it.
+
+    The state is kept in this internal subclass so that the layout of the public RWLock class is unchanged; the
+    non-virtual read lock methods of RWLock dispatch to this class, and the write lock is handled by the virtual
+    AbstractSmartLock implementation methods overridden here.
+*/
+class DistributedReaderRWLock final : public RWLock {
+public:
+    DLLLOCAL DistributedReaderRWLock() {
+    }
+
+    DLLLOCAL virtual ~DistributedReaderRWLock();
+
+    DLLLOCAL int readLockIntern(ExceptionSink* xsink, int64 timeout_ms);
+    DLLLOCAL int readUnlockIntern(ExceptionSink* xsink);
+    DLLLOCAL int tryReadLockIntern();
+    DLLLOCAL int numReadersIntern();
+    DLLLOCAL bool readLockOwnerIntern();
+
+    //! returns the lock with distributed readers or nullptr if the lock was not created with distributed readers
+    DLLLOCAL static DistributedReaderRWLock* get(const RWLock* rwl) {
+        return typeid(*rwl) == typeid(DistributedReaderRWLock)
+            ? static_cast<DistributedReaderRWLock*>(const_cast<RWLock*>(rwl))
+            : nullptr;
+    }
+
+    //! returns true if the current thread holds the read lock of the given lock
+    /** the inline RWLock::readLockOwner() only knows the state of locks without distributed readers
+    */
+    DLLLOCAL static bool readLockOwner(const RWLock* rwl) {
+        DistributedReaderRWLock* drwl = get(rwl);
+        return drwl ? drwl->readLockOwnerIntern() : rwl->readLockOwner();
+    }
+
+    //! returns true if the current thread holds the read or write lock of the given lock
+    DLLLOCAL static bool lockOwner(const RWLock* rwl) {
+        return rwl->writeLockOwner() || readLockOwner(rwl);
+    }
+
+    //! returns the number of threads waiting for the read lock of the given lock
+    DLLLOCAL static int getReadWaiting(const RWLock* rwl) {
+        DistributedReaderRWLock* drwl = get(rwl);
+        return drwl ? drwl->readRequests : rwl->getReadWaiting();
+    }
+
+private:
+    // read lock state for the threads assigned to a slot
+    struct alignas(64) reader_slot {
+        QoreThreadLock m;
+        tid_map_t tmap;     // map of TIDs to read lock counts
+        vlock_map_t vmap;   // map of TIDs to VLock data structures
+    };
+
+    reader_slot slots[QORE_DRWL_SLOTS];
+    // number of writers holding or waiting for the write lock; modified with the asl_lock held
+    std::atomic<int> writers = {0};
+    // condition for readers waiting for writers
+    QoreCondition read;
+    // number of readers waiting for writers; modified with the asl_lock held
+    int readRequests = 0;
+
+    DLLLOCAL reader_slot& getSlot(int mtid) {
+        return slots[mtid & (QORE_DRWL_SLOTS - 1)];
+    }
+
+    // copies all readers to the given map; returns true if any thread holds the read lock
+    DLLLOCAL bool getReaders(vlock_map_t& rvmap);
+
+    DLLLOCAL bool hasReaders();
+
+    // registers a read lock for the given thread; must be called with the slot lock held
+    DLLLOCAL void mark(reader_slot& s, int mtid, VLock* nvl);
+
+    // acquires the read lock without the asl_lock unless a writer holds or is waiting for the lock
+    DLLLOCAL int tryReadLockIntern(int mtid, VLock* nvl);
+
+    // must be called with the asl_lock held
+    DLLLOCAL int grabReadLockIntern(int mtid, VLock* nvl, int64 timeout_ms, ExceptionSink* xsink);
+
+    // releases one or all read locks held by the given thread; returns the number of read locks released
+    DLLLOCAL int releaseReadLock(int mtid, bool all, bool remove_resource);
+
+    // called with the asl_lock held when a writer releases or fails to acquire the write lock
+    DLLLOCAL void writerDone();
+
+    DLLLOCAL virtual int cleanupImpl();
+    DLLLOCAL virtual void signalAllImpl();
+    DLLLOCAL virtual void signalImpl();
+    DLLLOCAL virtual int releaseImpl();
+    DLLLOCAL virtual int grabImpl(int mtid, VLock* nvl, ExceptionSink* xsink, int64 timeout_ms = 0);
+    DLLLOCAL virtual int tryGrabImpl(int mtid, VLock* nvl);
+    DLLLOCAL virtual int externWaitImpl(int mtid, QoreCondition* cond, ExceptionSink* xsink, int64 timeout_ms = 0);
+    DLLLOCAL virtual void destructorImpl(ExceptionSink* xsink);
+};
+
+#endif
@@ -49,6 +49,11 @@ public:
         return is_declaration;
     }
 
+    DLLLOCAL virtual qore_stmt_op_e getExecOp(QoreValue& exp) const {
+        exp = this->exp;
+        return QSOP_EXPRESSION;
+    }
+
 private:
     QoreValue exp;
     bool is_declaration;
@@ -36,6 +36,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -310,13 +311,16 @@ public:
         @param self the object of the call target; not (necessarily) the current contextual object where the call is
         made.  "self" is needed to handle executing default argument expressions for normal (non-static) methods in
         case they reference class members or methods
+        @param check_args set to false if the arguments were verified against the variant's parameters at parse time,
+        in which case default arguments are not processed and arguments are not checked
 
         saves current program location in case there's an exception
     */
     DLLLOCAL CodeEvaluationHelper(ExceptionSink* n_xsink, const QoreFunction* func,
             const AbstractQoreFunctionVariant*& variant, const char* n_name, const QoreListNode* args = nullptr,
             QoreObject* self = nullptr, const qore_class_private* n_qc = nullptr, qore_call_t n_ct = CT_UNUSED,
-            bool is_copy = false, const qore_class_private* cctx = nullptr, QoreProgram* pgm_ctx = nullptr);
+            bool is_copy = false, const qore_class_private* cctx = nullptr, QoreProgram* pgm_ctx = nullptr,
+            bool check_args = true);
 
     //! Creates the object for evaluating the given code (function, method, closure) with the given arguments
     /**
@@ -436,7 +440,7 @@ protected:
     bool restore_stack = false;
 
     DLLLOCAL void init(const QoreFunction* func, const AbstractQoreFunctionVariant*& variant, bool is_copy,
-        const qore_class_private* cctx, QoreObject* self, QoreProgram* pgm_ctx);
+        const qore_class_private* cctx, QoreObject* self, QoreProgram* pgm_ctx, bool check_args = true);
 
     DLLLOCAL void setCallName(const QoreFunction* func);
 };
@@ -752,6 +756,48 @@ struct IList : public ilist_t {
         const_iterator aqfi, bool& internal_access, bool& stop) const;
 };
 
+// incremented every time committed function variants change; invalidates runtime variant caches
+DLLLOCAL extern std::atomic<unsigned> qore_variant_epoch;
+
+//! caches variants resolved at runtime by the types of the arguments in the call
+class RuntimeVariantCache {
+public:
+    DLLLOCAL RuntimeVariantCache() {
+    }
+
+    //! returns the type signature for the given arguments or 0 if the call cannot be cached
+    /** only calls with arguments whose types fully determine variant matching can be cached
+    */
+    DLLLOCAL static uint64_t getSignature(const QoreListNode* args, bool only_user);
+
+    //! returns the cached variant for the given signature, parse options, and class context, if any
+    DLLLOCAL const AbstractQoreFunctionVariant* find(uint64_t sig, int64 ppo,
+            const qore_class_private* class_ctx) const;
+
+    //! adds an entry to the cache
+    DLLLOCAL void add(uint64_t sig, int64 ppo, const qore_class_private* class_ctx,
+            const AbstractQoreFunctionVariant* variant);
+
+private:
+    static constexpr int QORE_VARIANT_CACHE_SIZE = 4;
+
+    struct entry_t {
+        std::atomic<uint64_t> sig = {0};
+        std::atomic<int64> ppo = {0};
+        std::atomic<const qore_class_private*> class_ctx = {nullptr};
+        std::atomic<const AbstractQoreFunctionVariant*> variant = {nullptr};
+    };
+
+    entry_t entries[QORE_VARIANT_CACHE_SIZE];
+    // sequence counter; odd while an update is in progress
+    std::atomic<unsigned> seq = {0};
+    // the class and variant epochs when the entries were added
+    std::atomic<unsigned> class_epoch = {0};
+    std::atomic<unsigned> variant_epoch = {0};
+    // the next entry to write; only accessed by the thread holding the sequence counter
+    int next = 0;
+};
+
 class QoreFunction : protected QoreReferenceCounter {
 friend class QoreFunctionIterator;
 friend class qore_external_function_iterator_private;
@@ -1001,6 +1047,11 @@ public:
     // this function will use destructive evaluation of "args"
     DLLLOCAL virtual QoreValue evalFunctionTmpArgs(const AbstractQoreFunctionVariant* variant, QoreListNode* args, QoreProgram* pgm, ExceptionSink* xsink) const;
 
+    // evaluates a call to a builtin variant identified at parse time where the argument types were verified at parse
+    // time to match the variant's parameters exactly; default arguments are not processed and arguments are not checked
+    DLLLOCAL QoreValue evalFunctionCheckedArgs(const AbstractQoreFunctionVariant* variant, const QoreListNode* args,
+            QoreProgram* pgm, ExceptionSink* xsink) const;
+
     // finds a variant and checks variant capabilities against current program parse options and executes the variant
     DLLLOCAL QoreValue evalDynamic(const QoreListNode* args, ExceptionSink* xsink) const;
 
@@ -1109,6 +1160,17 @@ protected:
 
     std::string from_module;
 
+    // runtime variant cache; not copied
+    mutable RuntimeVariantCache variant_cache;
+
+    // finds the best matching variant for the given arguments and raises an exception if none can be found
+    DLLLOCAL const AbstractQoreFunctionVariant* runtimeMatchVariant(ExceptionSink* xsink, const QoreListNode* args,
+            bool only_user, const qore_class_private* class_ctx, int64 ppo) const;
+
+    // returns -1 if the runtime parse options do not allow the variant to be called
+    DLLLOCAL int runtimeCheckVariantAccess(ExceptionSink* xsink, const AbstractQoreFunctionVariant* variant,
+            bool only_user, int64 ppo) const;
+
     DLLLOCAL int parseCheckReturnType() {
         if (parse_rt_done)
             return 0;
@@ -37,11 +37,15 @@
 #include "qore/intern/QoreParseListNode.h"
 #include "qore/intern/FunctionList.h"
 
+#include <atomic>
+
 class FunctionCallBase {
 protected:
     QoreParseListNode* parse_args = nullptr;
     QoreListNode* args = nullptr;
     const AbstractQoreFunctionVariant* variant = nullptr;
+    // true if the argument types were verified at parse time to match the builtin variant's parameters exactly
+    bool args_checked = false;
 
 public:
     DLLLOCAL FunctionCallBase(QoreParseListNode* parse_args, QoreListNode* args = nullptr) : parse_args(parse_args), args(args) {
@@ -50,7 +54,7 @@ public:
     DLLLOCAL FunctionCallBase(const FunctionCallBase& old) :
         parse_args(old.parse_args ? old.parse_args->listRefSelf() : nullptr),
         args(old.args ? old.args->listRefSelf() : nullptr),
-        variant(old.variant) {
+        variant(old.variant), args_checked(old.args_checked) {
     }
 
     DLLLOCAL FunctionCallBase(const FunctionCallBase& old, QoreListNode* n_args) : args(n_args), variant(old.variant) {
@@ -313,6 +317,42 @@ public:
     DLLLOCAL virtual AbstractQoreNode* makeReferenceNodeAndDerefImpl();
 };
 
+//! polymorphic inline cache for methods resolved at runtime by name at a method call site
+/** entries are keyed by the runtime class of the object and the calling class context; the cache is invalidated when
+    the global class epoch changes (i.e. when classes are committed or destroyed)
+
+    readers are lock-free; updates are serialized with a sequence counter, and any update that would have to wait is
+    simply skipped
+*/
+class MethodCallSiteCache {
+public:
+    DLLLOCAL MethodCallSiteCache() {
+    }
+
+    //! returns the cached method for the given class and context, if any
+    DLLLOCAL const QoreMethod* find(const QoreClass* cls, const qore_class_private* class_ctx) const;
+
+    //! adds an entry to the cache
+    DLLLOCAL void add(const QoreClass* cls, const qore_class_private* class_ctx, const QoreMethod* m);
+
+private:
+    static constexpr int QORE_METHOD_CACHE_SIZE = 4;
+
+    struct entry_t {
+        std::atomic<const QoreClass*> cls = {nullptr};
+        std::atomic<const qore_class_private*> class_ctx = {nullptr};
+        std::atomic<const QoreMethod*> method = {nullptr};
+    };
+
+    entry_t entries[QORE_METHOD_CACHE_SIZE];
+    // sequence counter; odd while an update is in progress
+    std::atomic<unsigned> seq = {0};
+    // the class epoch when the entries were added
+    std::atomic<unsigned> epoch = {0};
+    // the next entry to write; only accessed by the thread holding the sequence counter
+    int next = 0;
+};
+
 class AbstractMethodCallNode : public AbstractFunctionCallNode {
 protected:
     // if a method pointer can be resolved at parse time, then the class
@@ -320,6 +360,8 @@ protected:
     // is needed
     const QoreClass* qc;
     const QoreMethod* method;
+    // runtime method cache for calls where the object's class does not match the parse-time class
+    mutable MethodCallSiteCache method_cache;
 
     DLLLOCAL virtual int parseInitImpl(QoreValue& val, QoreParseContext& parse_context) = 0;
 
@@ -353,8 +353,9 @@ public:
     }
 
     DLLLOCAL LocalVar(const LocalVar& old) : name(old.name), closure_use(old.closure_use),
-            parse_assigned(old.parse_assigned), is_self(old.is_self), typeInfo(old.typeInfo),
-            refTypeInfo(old.refTypeInfo) {
+            parse_assigned(old.parse_assigned), is_self(old.is_self), strict_init(old.strict_init),
+            typeInfo(old.typeInfo),
+            refTypeInfo(old.refTypeInfo), slot(-1) {
     }
 
     DLLLOCAL ~LocalVar() {
@@ -377,7 +378,7 @@ public:
     }
 
     DLLLOCAL void instantiate(int64 parse_options) {
-        if (parse_options & PO_STRICT_TYPES) {
+        if (strict_init || (parse_options & PO_STRICT_TYPES)) {
             //printd(5, "LocalVar::instantiate() this: %p '%s' typeInfo: %s\n", this, name.c_str(),
             //    QoreTypeInfo::getName(typeInfo));
             instantiateIntern(QoreTypeInfo::getDefaultQoreValue(typeInfo), true);
@@ -515,6 +516,41 @@ public:
         return is_self;
     }
 
+    // called for variables declared with %strict-types in effect; they are always instantiated with a value
+    DLLLOCAL void setStrictInit() {
+        strict_init = true;
+    }
+
+    DLLLOCAL bool isStrictInit() const {
+        return strict_init;
+    }
+
+    // enables tracking of parse-time references to the variable; member reads accepted by the filter are counted
+    // separately
+    DLLLOCAL void parseTrackMemberReads(bool (*filter)(const char* member)) {
+        member_filter = filter;
+    }
+
+    // called for each parse-time reference to the variable
+    DLLLOCAL void parseRef() {
+        if (member_filter) {
+            ++parse_refs;
+        }
+    }
+
+    // called for a parse-time reference that only reads the given member of the variable's value
+    DLLLOCAL void parseMemberRead(const char* member) {
+        if (member_filter && member_filter(member)) {
+            ++parse_filtered_reads;
+        }
+    }
+
+    // returns true if all parse-time references to the variable only read members accepted by the filter
+    DLLLOCAL bool parseOnlyFilteredMemberReads() const {
+        assert(member_filter);
+        return parse_refs == parse_filtered_reads;
+    }
+
     DLLLOCAL void setSelf() {
         assert(!is_self);
         assert(name == "self");
@@ -525,12 +561,19 @@ private:
     std::string name;
     bool closure_use = false,
         parse_assigned = false,
-        is_self = false;
+        is_self = false,
+        strict_init = false;
+    // parse-time reference tracking
+    bool (*member_filter)(const char* member) = nullptr;
+    unsigned parse_refs = 0,
+        parse_filtered_reads = 0;
     const QoreTypeInfo* typeInfo = nullptr;
     const QoreTypeInfo* refTypeInfo = nullptr;
+    // offset of the variable's value from the start of the frame on the thread-local variable stack; -1 = unknown
+    mutable std::atomic<int> slot = {-1};
 
     DLLLOCAL LocalVarValue* get_var() const {
-        return thread_find_lvar(name.c_str());
+        return thread_find_lvar(name.c_str(), slot);
     }
 };
 
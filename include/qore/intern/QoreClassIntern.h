@@ -1436,6 +1436,9 @@ public:
 typedef vector_set_t<qore_class_private*> qcp_set_t;
 //typedef std::set<qore_class_private*> qcp_set_t;
 
+// set of class and hashdecl pointers; used when checking if objects of a class can be part of a recursive reference
+typedef vector_set_t<const void*> qcv_set_t;
+
 // BCNode
 // base class pointer
 class BCNode {
@@ -1824,6 +1827,10 @@ public:
 typedef vector_set_t<QoreClass*> qc_set_t;
 //typedef std::set<QoreClass*> qc_set_t;
 
+// global class epoch; incremented when classes are committed or destroyed to invalidate runtime method and member
+// caches
+DLLLOCAL extern std::atomic<unsigned> qore_class_epoch;
+
 // private QoreClass implementation
 // only dynamically allocated; reference counter managed in "refs"
 class qore_class_private {
@@ -1933,6 +1940,10 @@ public:
     // class language
     std::string lang = "Qore";
 
+    // cycle-free status: -1 = not yet determined, 0 = objects of the class may be part of a recursive reference,
+    // 1 = objects of the class can never be part of a recursive reference
+    mutable std::atomic<int> cycle_free = {-1};
+
     // class key-value store
     typedef std::map<std::string, QoreValue> kvmap_t;
     kvmap_t kvmap;
@@ -3036,6 +3047,17 @@ public:
     DLLLOCAL int addUserMethod(const char* mname, MethodVariantBase* f, bool n_static);
     DLLLOCAL void addLocalMembersForInit();
 
+    //! returns true if objects of the class can never be part of a recursive reference
+    /** this is only true for committed user classes where dynamic members cannot be added and all members in the
+        hierarchy are declared with types that cannot hold a reference to an object of a class that could be part of
+        a recursive reference; objects of such classes do not need to be scanned for recursive references
+    */
+    DLLLOCAL bool isCycleFree() const;
+
+    // checks if objects of the class can never be part of a recursive reference; "vset" holds the classes and
+    // hashdecls already being checked
+    DLLLOCAL bool checkCycleFree(qcv_set_t& vset) const;
+
     DLLLOCAL QoreValue evalPseudoMethod(const QoreValue n, const char* name, const QoreListNode* args,
             ExceptionSink* xsink) const;
 
@@ -0,0 +1,216 @@
+/* -*- mode: c++; indent-tabs-mode: nil -*- */
+/*
+  QoreDistributedRWLock.h
+
+  internal read-write lock with distributed reader counters
+
+  Qore Programming Language
+
+  Copyright (C) 2003 - 2024 Qore Technologies, s.r.o.
+
+  Permission is hereby granted, free of charge, to any person obtaining a
+  copy of this software and associated documentation files (the "Software"),
+  to deal in the Software without restriction, including without limitation
+  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+  and/or sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+  DEALINGS IN THE SOFTWARE.
+
+  Note that the Qore library is released under a choice of three open-source
+  licenses: MIT (as above), LGPL 2+, or GPL 2+; see README-LICENSE for more
+  information.
+*/
+
+#ifndef _QORE_QOREDISTRIBUTEDRWLOCK_H
+#define _QORE_QOREDISTRIBUTEDRWLOCK_H
+
+#include <atomic>
+
+//! number of reader counter slots in a QoreDistributedRWLock; must be a power of 2
+#define QORE_DRWL_SLOTS 16
+
+//! a read-write lock for read-mostly data where readers do not share a cache line
+/** Readers increment a counter in one of several cache-line-sized slots selected by the thread ID and only acquire
+    the internal mutex if a writer holds or is waiting for the lock; writers set the writer flag and wait until all
+    reader counters are zero.
+
+    Provides the same interface as QoreRWLock; writers have priority over new readers, so neither the read lock nor
+    the write lock may be acquired recursively.
+*/
+class QoreDistributedRWLock {
+public:
+    //! creates and initializes the lock
+    DLLLOCAL QoreDistributedRWLock() {
+    }
+
+    //! grabs the write lock
+    DLLLOCAL int wrlock() {
+        int tid = q_gettid();
+        AutoLocker al(l);
+        assert(write_tid.load(std::memory_order_relaxed) != tid);
+        while (writer.load(std::memory_order_relaxed)) {
+            cond.wait(l);
+        }
+        writer.store(true, std::memory_order_seq_cst);
+        while (hasReaders()) {
+            cond.wait(l);
+        }
+        write_tid.store(tid, std::memory_order_relaxed);
+        return 0;
+    }
+
+    //! tries to grab the write lock; does not block if unsuccessful; returns 0 if successful
+    DLLLOCAL int trywrlock() {
+        int tid = q_gettid();
+        AutoLocker al(l);
+        if (writer.load(std::memory_order_relaxed)) {
+            return -1;
+        }
+        writer.store(true, std::memory_order_seq_cst);
+        if (hasReaders()) {
+            writer.store(false, std::memory_order_seq_cst);
+            cond.broadcast();
+            return -1;
+        }
+        write_tid.store(tid, std::memory_order_relaxed);
+        return 0;
+    }
+
+    //! unlocks the lock (assumes the lock is locked)
+    DLLLOCAL int unlock() {
+        if (write_tid.load(std::memory_order_relaxed) == q_gettid()) {
+            AutoLocker al(l);
+            write_tid.store(-1, std::memory_order_relaxed);
+            writer.store(false, std::memory_order_seq_cst);
+            cond.broadcast();
+        } else {
+            readUnlock(getSlot());
+        }
+        return 0;
+    }
+
+    //! grabs the read lock
+    DLLLOCAL int rdlock() {
+        std::atomic<int>& cnt = getSlot();
+        while (true) {
+            cnt.fetch_add(1, std::memory_order_seq_cst);
+            if (!writer.load(std::memory_order_seq_cst)) {
+                return 0;
+            }
+            // back off and wait for the writer to release the lock
+            readUnlock(cnt);
+            AutoLocker al(l);
+            while (writer.load(std::memory_order_relaxed)) {
+                cond.wait(l);
+            }
+        }
+    }
+
+    //! tries to grab the read lock; does not block if unsuccessful; returns 0 if successful
+    DLLLOCAL int tryrdlock() {
+        std::atomic<int>& cnt = getSlot();
+        cnt.fetch_add(1, std::memory_order_seq_cst);
+        if (!writer.load(std::memory_order_seq_cst)) {
+            return 0;
+        }
+        readUnlock(cnt);
+        return -1;
+    }
+
+private:
+    //! a reader counter in its own cache line
+    struct alignas(64) reader_slot {
+        std::atomic<int> cnt = {0};
+    };
+
+    reader_slot slots[QORE_DRWL_SLOTS];
+    //! set while a writer holds or is waiting for the lock
+    std::atomic<bool> writer = {false};
+    //! the TID of the thread holding the write lock
+    std::atomic<int> write_tid = {-1};
+    //! the lock and condition used for blocking
+    QoreThreadLock l;
+    QoreCondition cond;
+
+    DLLLOCAL std::atomic<int>& getSlot() {
+        return slots[q_gettid() & (QORE_DRWL_SLOTS - 1)].cnt;
+    }
+
+    DLLLOCAL bool hasReaders() const {
+        for (unsigned i = 0; i < QORE_DRWL_SLOTS; ++i) {
+            if (slots[i].cnt.load(std::memory_order_seq_cst)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    DLLLOCAL void readUnlock(std::atomic<int>& cnt) {
+        // wake up a waiting writer when this slot becomes empty
+        if (cnt.fetch_sub(1, std::memory_order_seq_cst) == 1 && writer.load(std::memory_order_seq_cst)) {
+            AutoLocker al(l);
+            cond.broadcast();
+        }
+    }
+
+    //! this function is not implemented; it is here as a private function in order to prohibit it from being used
+    DLLLOCAL QoreDistributedRWLock(const QoreDistributedRWLock&) = delete;
+    //! this function is not implemented; it is here as a private function in order to prohibit it from being used
+    DLLLOCAL QoreDistributedRWLock& operator=(const QoreDistributedRWLock&) = delete;
+};
+
+//! provides an exception-safe way to hold the read lock of a QoreDistributedRWLock on the stack
+class QoreAutoDistributedRWReadLocker {
+public:
+    //! creates the object and grabs the read lock
+    DLLLOCAL QoreAutoDistributedRWReadLocker(QoreDistributedRWLock& n_l) : l(n_l) {
+        l.rdlock();
+    }
+
+    //! destroys the object and releases the lock
+    DLLLOCAL ~QoreAutoDistributedRWReadLocker() {
+        l.unlock();
+    }
+
+private:
+    //! the lock that will be managed
+    QoreDistributedRWLock& l;
+
+    DLLLOCAL QoreAutoDistributedRWReadLocker(const QoreAutoDistributedRWReadLocker&) = delete;
+    DLLLOCAL QoreAutoDistributedRWReadLocker& operator=(const QoreAutoDistributedRWReadLocker&) = delete;
+    DLLLOCAL void* operator new(size_t) = delete;
+};
+
+//! provides an exception-safe way to hold the write lock of a QoreDistributedRWLock on the stack
+class QoreAutoDistributedRWWriteLocker {
+public:
+    //! creates the object and grabs the write lock
+    DLLLOCAL QoreAutoDistributedRWWriteLocker(QoreDistributedRWLock& n_l) : l(n_l) {
+        l.wrlock();
+    }
+
+    //! destroys the object and releases the lock
+    DLLLOCAL ~QoreAutoDistributedRWWriteLocker() {
+        l.unlock();
+    }
+
+private:
+    //! the lock that will be managed
+    QoreDistributedRWLock& l;
+
+    DLLLOCAL QoreAutoDistributedRWWriteLocker(const QoreAutoDistributedRWWriteLocker&) = delete;
+    DLLLOCAL QoreAutoDistributedRWWriteLocker& operator=(const QoreAutoDistributedRWWriteLocker&) = delete;
+    DLLLOCAL void* operator new(size_t) = delete;
+};
+
+#endif
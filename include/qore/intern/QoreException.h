@@ -35,25 +35,7 @@
 
 #include <cstdarg>
 #include <string>
-
-struct QoreExceptionBase {
-    qore_call_t type;
-    QoreListNode* callStack = new QoreListNode(autoTypeInfo);
-    QoreValue err, desc, arg;
-
-    DLLLOCAL QoreExceptionBase(QoreValue n_err, QoreValue n_desc, QoreValue n_arg = QoreValue(),
-        qore_call_t n_type = CT_BUILTIN);
-
-    DLLLOCAL QoreExceptionBase(const QoreExceptionBase& old) :
-        type(old.type), callStack(old.callStack->copy()),
-        err(old.err.refSelf()), desc(old.desc.refSelf()),
-        arg(old.arg.refSelf()) {
-    }
-
-    DLLLOCAL ~QoreExceptionBase() {
-        assert(!callStack);
-    }
-};
+#include <vector>
 
 struct QoreExceptionLocation : QoreProgramLineLocation {
     std::string file;
@@ -98,6 +80,43 @@ struct QoreExceptionLocation : QoreProgramLineLocation {
     }
 };
 
+// call stack frame captured when an exception is raised; only converted to a CallStackInfo hash when needed
+struct QoreExceptionStackFrame : public QoreExceptionLocation {
+    std::string code;
+    unsigned long statementid = 0;
+    unsigned programid = 0;
+    qore_call_t type;
+    bool has_pgm = false;
+    // set if the location has a source pointer; "source" is only set in the CallStackInfo hash in this case
+    bool has_source = false;
+
+    DLLLOCAL QoreExceptionStackFrame(const QoreStackLocation& stack_loc);
+};
+
+typedef std::vector<QoreExceptionStackFrame> exception_frame_vec_t;
+
+struct QoreExceptionBase {
+    qore_call_t type;
+    // call stack entries added after the exception was raised, followed by materialized frames
+    mutable QoreListNode* callStack = new QoreListNode(autoTypeInfo);
+    // call stack frames captured when the exception was raised that have not yet been added to callStack
+    mutable exception_frame_vec_t frames;
+    QoreValue err, desc, arg;
+
+    DLLLOCAL QoreExceptionBase(QoreValue n_err, QoreValue n_desc, QoreValue n_arg = QoreValue(),
+        qore_call_t n_type = CT_BUILTIN);
+
+    DLLLOCAL QoreExceptionBase(const QoreExceptionBase& old) :
+        type(old.type), callStack(old.callStack->copy()), frames(old.frames),
+        err(old.err.refSelf()), desc(old.desc.refSelf()),
+        arg(old.arg.refSelf()) {
+    }
+
+    DLLLOCAL ~QoreExceptionBase() {
+        assert(!callStack);
+    }
+};
+
 class QoreException : public QoreExceptionBase, public QoreExceptionLocation {
     friend class ExceptionSink;
     friend struct qore_es_private;
@@ -107,7 +126,8 @@ public:
 
     // called for generic exceptions
     DLLLOCAL QoreHashNode* makeExceptionObjectAndDelete(ExceptionSink *xsink);
-    DLLLOCAL QoreHashNode* makeExceptionObject(int level = 0) const;
+    // the call stack is only added if with_callstack is true
+    DLLLOCAL QoreHashNode* makeExceptionObject(int level = 0, bool with_callstack = true) const;
 
     // called for runtime exceptions
     DLLLOCAL QoreException(const char *n_err, QoreValue n_desc, QoreValue n_arg = QoreValue())
@@ -176,10 +196,20 @@ public:
                     }
                 }
             }
+            // check frames not yet added to the call stack
+            for (auto& i : frames) {
+                if (i.file != "<builtin>") {
+                    loc = i;
+                    return;
+                }
+            }
         }
         loc = *this;
     }
 
+    //! returns the complete call stack, creating hashes for any captured frames
+    DLLLOCAL QoreListNode* getCallStack() const;
+
     DLLLOCAL void del(ExceptionSink *xsink);
 
     DLLLOCAL QoreException* rethrow();
@@ -197,6 +227,7 @@ protected:
     DLLLOCAL static const char* getType(qore_call_t type);
 
     DLLLOCAL static QoreHashNode* getStackHash(const QoreCallStackElement& cse);
+    DLLLOCAL static QoreHashNode* getStackHash(const QoreExceptionStackFrame& frame);
 
 private:
     DLLLOCAL QoreException& operator=(const QoreException&) = delete;
@@ -33,93 +33,254 @@
 
 #define _QORE_QOREHASHNODEINTERN_H
 
-#include <list>
+#include "qore/intern/xxhash.h"
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+// hashes with more members than this are indexed, smaller hashes are searched linearly
+#define QORE_HASH_LINEAR_MAX 8
+
+// an interned hash key with a precomputed hash code
+/** interned keys are created for string literals used as hash keys when parsing; they are unique for each key
+    string, so members created from them can share the key string and lookups can compare them by address.  Keys are
+    reference counted; each hash member, parse node, and hash shape using a key holds a reference, and the key is
+    removed from the table of interned keys when the last reference is released
+*/
+class QoreHashKey {
+public:
+    DLLLOCAL QoreHashKey(const char* n_key, size_t n_len) : key(n_key, n_len), hash(hashCode(n_key, n_len)) {
+    }
+
+    DLLLOCAL const char* c_str() const {
+        return key.c_str();
+    }
+
+    DLLLOCAL size_t size() const {
+        return key.size();
+    }
+
+    DLLLOCAL size_t getHash() const {
+        return hash;
+    }
+
+    DLLLOCAL static size_t hashCode(const char* key, size_t len) {
+#if TARGET_BITS == 64
+        return XXH64(key, len, 0);
+#else
+        return XXH32(key, len, 0);
+#endif
+    }
+
+    DLLLOCAL void ref() const {
+        refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //! releases a reference; the key is deleted when the last reference is released
+    DLLLOCAL void deref() const;
+
+    //! returns a new reference to the interned key for the given string in the default character encoding
+    DLLLOCAL static const QoreHashKey* get(const char* key);
+
+private:
+    const std::string key;
+    const size_t hash;
+    mutable std::atomic<unsigned> refs = {1};
+};
 
 // to maintain the order of inserts
+/** the key string is either an interned key or is stored in the same allocation directly after the member
+*/
 class HashMember {
 public:
     QoreValue val;
-    std::string key;
+    // hash code of the key; always set for interned keys, otherwise only set when the hash is indexed
+    size_t hash;
+
+    DLLLOCAL static HashMember* create(const char* key, size_t len) {
+        return new (len + 1) HashMember(key, len);
+    }
+
+    DLLLOCAL static HashMember* create(const char* key) {
+        return create(key, strlen(key));
+    }
 
-    DLLLOCAL HashMember(const char* n_key) : key(n_key) {
+    DLLLOCAL static HashMember* create(const QoreHashKey& key) {
+        return new (0) HashMember(key);
+    }
+
+    //! creates a new member with the same key as the given member; interned keys are shared
+    DLLLOCAL static HashMember* create(const HashMember& m) {
+        if (m.ikey) {
+            return create(*m.ikey);
+        }
+        HashMember* rv = create(m.getKey(), m.len);
+        rv->hash = m.hash;
+        return rv;
     }
 
     DLLLOCAL ~HashMember() {
+        if (ikey) {
+            ikey->deref();
+        }
     }
-};
 
-typedef std::list<HashMember*> qhlist_t;
+    DLLLOCAL static void operator delete(void* p) {
+        ::operator delete(p);
+    }
 
-#ifdef HAVE_QORE_HASH_MAP
-//#warning compiling with hash_map
-#include <qore/hash_map_include.h>
-#include "qore/intern/xxhash.h"
+    DLLLOCAL const char* getKey() const {
+        return ikey ? ikey->c_str() : reinterpret_cast<const char*>(this + 1);
+    }
 
-typedef HASH_MAP<const char*, qhlist_t::iterator, qore_hash_str, eqstr> hm_hm_t;
-#else
-typedef std::map<const char*, qhlist_t::iterator, ltstr> hm_hm_t;
-#endif
+    DLLLOCAL size_t getKeyLen() const {
+        return len;
+    }
 
-// QoreHashIterator private class
-class qhi_priv {
-public:
-    qhlist_t::iterator i;
-    bool val;
+    //! returns the interned key or nullptr if the key is not interned
+    DLLLOCAL const QoreHashKey* getInternedKey() const {
+        return ikey;
+    }
 
-    DLLLOCAL qhi_priv() : val(false) {
+    //! returns true if the member has the given key
+    DLLLOCAL bool matches(const QoreHashKey& key) const {
+        // interned keys are unique, so different interned keys never match
+        return ikey ? ikey == &key : (hash == key.getHash() || !hash) && !strcmp(getKey(), key.c_str());
     }
 
-    DLLLOCAL qhi_priv(const qhi_priv& old) : i(old.i), val(old.val) {
+private:
+    // the interned key, if any
+    const QoreHashKey* ikey;
+    // the length of the key
+    size_t len;
+
+    DLLLOCAL HashMember(const char* key, size_t len) : hash(0), ikey(nullptr), len(len) {
+        char* p = reinterpret_cast<char*>(this + 1);
+        memcpy(p, key, len);
+        p[len] = '\0';
     }
 
-    DLLLOCAL bool valid() const {
-        return val;
+    DLLLOCAL HashMember(const QoreHashKey& key) : hash(key.getHash()), ikey(&key), len(key.size()) {
+        key.ref();
+    }
+
+    DLLLOCAL static void* operator new(size_t size, size_t extra) {
+        return ::operator new(size + extra);
     }
+};
+
+// members in insertion order; deleted members are left as nullptr entries until the list is compacted
+typedef std::vector<HashMember*> qhlist_t;
 
-    DLLLOCAL bool next(qhlist_t& ml) {
-        //printd(0, "qhi_priv::next() this: %p val: %d\n", this, val);
-        if (!val) {
-            if (ml.begin() != ml.end()) {
-                i = ml.begin();
-                val = true;
+// open-addressed index of member positions + 1; 0 = empty slot
+typedef std::vector<unsigned> hm_hm_t;
+
+// the key layout of hashes created from the same hash literal or hashdecl
+/** the keys are interned and unique, and the index for shapes with more than QORE_HASH_LINEAR_MAX keys is built
+    once for the shape, so hashes can be created with all keys of the shape without looking up or hashing any keys
+*/
+class QoreHashShape {
+friend class qore_hash_private;
+public:
+    //! takes over the references to the keys
+    DLLLOCAL QoreHashShape(std::vector<const QoreHashKey*>&& n_keys) : keys(std::move(n_keys)) {
+        if (keys.size() <= QORE_HASH_LINEAR_MAX) {
+            return;
+        }
+        // the index has the same layout as an index built by qore_hash_private for the same keys
+        size_t size = 16;
+        while (size < keys.size() * 4) {
+            size <<= 1;
+        }
+        index.assign(size, 0);
+        size_t mask = size - 1;
+        for (size_t i = 0, e = keys.size(); i < e; ++i) {
+            size_t j = keys[i]->getHash() & mask;
+            while (index[j]) {
+                j = (j + 1) & mask;
             }
-        } else {
-            ++i;
-            if (i == ml.end())
-                val = false;
+            index[j] = i + 1;
         }
-        return val;
     }
 
-    DLLLOCAL bool prev(qhlist_t& ml) {
-        if (!val) {
-            if (ml.begin() != ml.end()) {
-                i = ml.end();
-                --i;
-                val = true;
-            }
-        } else {
-            if (i == ml.begin())
-                val = false;
-            else
-                --i;
+    DLLLOCAL size_t size() const {
+        return keys.size();
+    }
+
+    DLLLOCAL ~QoreHashShape() {
+        for (const QoreHashKey* k : keys) {
+            k->deref();
         }
+    }
+
+    DLLLOCAL const QoreHashKey& getKey(size_t i) const {
+        return *keys[i];
+    }
+
+private:
+    std::vector<const QoreHashKey*> keys;
+    hm_hm_t index;
+};
+
+class qore_hash_private;
+
+// QoreHashIterator private class
+class qhi_priv {
+public:
+    // the current member
+    HashMember* m = nullptr;
+    // the position of the current member in the member list
+    size_t i = 0;
+    // the member list generation when the position was set
+    unsigned gen = 0;
+    bool val = false;
+
+    DLLLOCAL qhi_priv() {
+    }
+
+    DLLLOCAL qhi_priv(const qhi_priv& old) : m(old.m), i(old.i), gen(old.gen), val(old.val) {
+    }
+
+    DLLLOCAL bool valid() const {
         return val;
     }
 
+    DLLLOCAL inline bool next(const qore_hash_private& h);
+
+    DLLLOCAL inline bool prev(const qore_hash_private& h);
+
+    // returns true if the current member is the first member
+    DLLLOCAL inline bool first(const qore_hash_private& h);
+
+    // returns true if the current member is the last member
+    DLLLOCAL inline bool last(const qore_hash_private& h);
+
     DLLLOCAL void reset() {
         val = false;
+        m = nullptr;
     }
 
     DLLLOCAL static qhi_priv* get(HashIterator& i) {
         return i.priv;
     }
+
+    // updates the position if the member list has been compacted since the position was set
+    DLLLOCAL inline void sync(const qore_hash_private& h);
+
+private:
+    DLLLOCAL inline bool set(const qore_hash_private& h, size_t pos);
 };
 
 class qore_hash_private {
 public:
     qhlist_t member_list;
+    // the index is only allocated for hashes with more than QORE_HASH_LINEAR_MAX members; the size is a power of 2
     hm_hm_t hm;
+    // the number of members
+    size_t len = 0;
+    // incremented when the member list is compacted
+    unsigned generation = 0;
     // either hashdecl or complexTypeInfo can be set, but not both
     const TypedHashDecl* hashdecl = nullptr;
     const QoreTypeInfo* complexTypeInfo = nullptr;
@@ -136,7 +297,141 @@ public:
     // hashes should always be empty by the time they are deleted
     // because object destructors need to be run...
     DLLLOCAL ~qore_hash_private() {
-        assert(member_list.empty());
+        assert(!len);
+    }
+
+    static constexpr size_t npos = (size_t)-1;
+
+    //! returns the position of the member with the given key in the member list or npos
+    DLLLOCAL size_t findPos(const char* key) const {
+        if (hm.empty()) {
+            for (size_t i = 0, e = member_list.size(); i < e; ++i) {
+                HashMember* m = member_list[i];
+                if (m && !strcmp(m->getKey(), key)) {
+                    return i;
+                }
+            }
+            return npos;
+        }
+
+        size_t h = QoreHashKey::hashCode(key, strlen(key));
+        size_t mask = hm.size() - 1;
+        for (size_t i = h & mask; hm[i]; i = (i + 1) & mask) {
+            HashMember* m = member_list[hm[i] - 1];
+            if (m->hash == h && !strcmp(m->getKey(), key)) {
+                return hm[i] - 1;
+            }
+        }
+        return npos;
+    }
+
+    //! returns the position of the member with the given interned key in the member list or npos
+    /** the key's hash code is precomputed, and members with interned keys are compared by address
+    */
+    DLLLOCAL size_t findPos(const QoreHashKey& key) const {
+        if (hm.empty()) {
+            for (size_t i = 0, e = member_list.size(); i < e; ++i) {
+                HashMember* m = member_list[i];
+                if (m && m->matches(key)) {
+                    return i;
+                }
+            }
+            return npos;
+        }
+
+        size_t mask = hm.size() - 1;
+        for (size_t i = key.getHash() & mask; hm[i]; i = (i + 1) & mask) {
+            HashMember* m = member_list[hm[i] - 1];
+            if (m->matches(key)) {
+                return hm[i] - 1;
+            }
+        }
+        return npos;
+    }
+
+    //! returns the position of the member with the same key as the given member or npos
+    DLLLOCAL size_t findPos(const HashMember& m) const {
+        return m.getInternedKey() ? findPos(*m.getInternedKey()) : findPos(m.getKey());
+    }
+
+    DLLLOCAL HashMember* findMemberIntern(const char* key) const {
+        size_t pos = findPos(key);
+        return pos == npos ? nullptr : member_list[pos];
+    }
+
+    DLLLOCAL HashMember* findMemberIntern(const QoreHashKey& key) const {
+        size_t pos = findPos(key);
+        return pos == npos ? nullptr : member_list[pos];
+    }
+
+    //! returns the position of the first member at or after the given position or npos
+    DLLLOCAL size_t nextPos(size_t pos) const {
+        for (size_t e = member_list.size(); pos < e; ++pos) {
+            if (member_list[pos]) {
+                return pos;
+            }
+        }
+        return npos;
+    }
+
+    //! returns the position of the last member before the given position or npos
+    DLLLOCAL size_t prevPos(size_t pos) const {
+        while (pos) {
+            if (member_list[--pos]) {
+                return pos;
+            }
+        }
+        return npos;
+    }
+
+    DLLLOCAL HashMember* front() const {
+        size_t pos = nextPos(0);
+        return pos == npos ? nullptr : member_list[pos];
+    }
+
+    DLLLOCAL HashMember* back() const {
+        // deleted members are never left at the end of the list
+        assert(member_list.empty() || member_list.back());
+        return member_list.empty() ? nullptr : member_list.back();
+    }
+
+    //! appends a new member to the member list
+    DLLLOCAL void addMember(HashMember* m) {
+        // deleted members are removed when the list would otherwise have to grow
+        if (member_list.size() == member_list.capacity() && member_list.size() != len) {
+            compact();
+        }
+        member_list.push_back(m);
+        ++len;
+
+        if (!hm.empty()) {
+            if (!m->getInternedKey()) {
+                m->hash = QoreHashKey::hashCode(m->getKey(), m->getKeyLen());
+            }
+            if (len * 2 > hm.size()) {
+                rebuildIndex();
+            } else {
+                indexMember(member_list.size() - 1);
+            }
+        } else if (len > QORE_HASH_LINEAR_MAX) {
+            rebuildIndex();
+        }
+    }
+
+    //! removes the member at the given position from the hash and deletes it; the value must already be cleared
+    DLLLOCAL void removeMember(size_t pos) {
+        HashMember* m = member_list[pos];
+        assert(m);
+        if (!hm.empty()) {
+            unindexMember(pos);
+        }
+        member_list[pos] = nullptr;
+        --len;
+        // trailing deleted members can be removed without changing the positions of other members
+        while (!member_list.empty() && !member_list.back()) {
+            member_list.pop_back();
+        }
+        delete m;
     }
 
     DLLLOCAL int checkValid(ExceptionSink* xsink) {
@@ -149,6 +444,15 @@ public:
 
     DLLLOCAL QoreValue getKeyValueIntern(const char* key) const;
 
+    //! returns the value of the given interned key without a reference; raises an exception for unknown hashdecl keys
+    DLLLOCAL QoreValue getKeyValue(const QoreHashKey& key, ExceptionSink* xsink) const {
+        if (checkKey(key.c_str(), xsink)) {
+            return QoreValue();
+        }
+        HashMember* m = findMemberIntern(key);
+        return m ? m->val : QoreValue();
+    }
+
     DLLLOCAL QoreValue getKeyValueExistence(const char* key, bool& exists, ExceptionSink* xsink) const;
 
     DLLLOCAL QoreValue getKeyValueExistenceIntern(const char* key, bool& exists) const;
@@ -163,10 +467,21 @@ public:
     DLLLOCAL QoreValue getReferencedKeyValueIntern(const char* key, bool& exists) const {
         assert(key);
 
-        hm_hm_t::const_iterator i = hm.find(key);
-        if (i != hm.end()) {
+        HashMember* m = findMemberIntern(key);
+        if (m) {
             exists = true;
-            return (*(i->second))->val.refSelf();
+            return m->val.refSelf();
+        }
+
+        exists = false;
+        return QoreValue();
+    }
+
+    DLLLOCAL QoreValue getReferencedKeyValueIntern(const QoreHashKey& key, bool& exists) const {
+        HashMember* m = findMemberIntern(key);
+        if (m) {
+            exists = true;
+            return m->val.refSelf();
         }
 
         exists = false;
@@ -175,11 +490,11 @@ public:
 
     DLLLOCAL int64 getKeyAsBigInt(const char* key, bool &found) const {
         assert(key);
-        hm_hm_t::const_iterator i = hm.find(key);
+        HashMember* m = findMemberIntern(key);
 
-        if (i != hm.end()) {
+        if (m) {
             found = true;
-            return (*(i->second))->val.getAsBigInt();
+            return m->val.getAsBigInt();
         }
 
         found = false;
@@ -188,11 +503,11 @@ public:
 
     DLLLOCAL bool getKeyAsBool(const char* key, bool& found) const {
         assert(key);
-        hm_hm_t::const_iterator i = hm.find(key);
+        HashMember* m = findMemberIntern(key);
 
-        if (i != hm.end()) {
+        if (m) {
             found = true;
-            return (*(i->second))->val.getAsBool();
+            return m->val.getAsBool();
         }
 
         found = false;
@@ -201,70 +516,91 @@ public:
 
     DLLLOCAL bool existsKey(const char* key) const {
         assert(key);
-        return hm.find(key) != hm.end();
+        return findPos(key) != npos;
     }
 
     DLLLOCAL bool existsKeyValue(const char* key) const {
         assert(key);
-        hm_hm_t::const_iterator i = hm.find(key);
-        if (i == hm.end())
-            return false;
-        return !(*(i->second))->val.isNothing();
+        HashMember* m = findMemberIntern(key);
+        return m && !m->val.isNothing();
     }
 
     DLLLOCAL HashMember* findMember(const char* key) {
         assert(key);
-        hm_hm_t::iterator i = hm.find(key);
-        return i != hm.end() ? (*(i->second)) : nullptr;
+        return findMemberIntern(key);
     }
 
-   DLLLOCAL HashMember* findCreateMember(const char* key) {
+    DLLLOCAL HashMember* findCreateMember(const char* key) {
         // otherwise create the new hash entry
         HashMember* om = findMember(key);
         if (om)
             return om;
 
-        om = new HashMember(key);
+        om = HashMember::create(key);
         assert(om->val.isNothing());
-        member_list.push_back(om);
-
-        // add to the map
-        qhlist_t::iterator i = member_list.end();
-        --i;
-        hm[om->key.c_str()] = i;
+        addMember(om);
 
         // return the new member
         return om;
     }
 
+    DLLLOCAL HashMember* findCreateMember(const QoreHashKey& key) {
+        HashMember* om = findMemberIntern(key);
+        if (om)
+            return om;
+
+        om = HashMember::create(key);
+        addMember(om);
+        return om;
+    }
+
+    //! finds or creates a member with the same key as the given member; interned keys are shared
+    DLLLOCAL HashMember* findCreateMember(const HashMember& m) {
+        size_t pos = findPos(m);
+        if (pos != npos)
+            return member_list[pos];
+
+        HashMember* om = HashMember::create(m);
+        addMember(om);
+        return om;
+    }
+
     DLLLOCAL QoreValue& getValueRef(const char* key) {
         return findCreateMember(key)->val;
     }
 
-    // NOTE: does not delete the value, this must be done by the caller before this call
-    // also does not delete map entry; must be done outside this call
-    DLLLOCAL void internDeleteKey(qhlist_t::iterator i) {
-        HashMember* om = *i;
+    DLLLOCAL QoreValue& getValueRef(const QoreHashKey& key) {
+        return findCreateMember(key)->val;
+    }
 
-        member_list.erase(i);
+    //! creates members with no value for all keys of the shape in an empty hash
+    /** members are created in the order of the shape's keys, so the member at position i has key i of the shape
+    */
+    DLLLOCAL void initShape(const QoreHashShape& shape) {
+        assert(!len && member_list.empty() && hm.empty());
+        member_list.reserve(shape.size());
+        for (const QoreHashKey* k : shape.keys) {
+            member_list.push_back(HashMember::create(*k));
+        }
+        len = member_list.size();
+        hm = shape.index;
+    }
 
-        // free om memory
-        delete om;
+    // NOTE: does not delete the value, this must be done by the caller before this call
+    DLLLOCAL void internDeleteKey(size_t pos) {
+        removeMember(pos);
     }
 
     DLLLOCAL void deleteKey(const char* key, ExceptionSink *xsink) {
         assert(key);
 
-        hm_hm_t::iterator i = hm.find(key);
+        size_t pos = findPos(key);
 
-        if (i == hm.end())
+        if (pos == npos)
             return;
 
-        qhlist_t::iterator li = i->second;
-        hm.erase(i);
-
         // dereference node if present
-        AbstractQoreNode* n = (*li)->val.assignNothing();
+        AbstractQoreNode* n = member_list[pos]->val.assignNothing();
         if (n) {
             if (needs_scan(n))
                 incScanCount(-1);
@@ -274,7 +610,7 @@ public:
             n->deref(xsink);
         }
 
-        internDeleteKey(li);
+        internDeleteKey(pos);
     }
 
     // removes the value and dereferences it, without performing a delete on it
@@ -287,19 +623,16 @@ public:
     DLLLOCAL QoreValue takeKeyValueIntern(const char* key, bool& exists) {
         assert(key);
 
-        hm_hm_t::iterator i = hm.find(key);
+        size_t pos = findPos(key);
 
-        if (i == hm.end()) {
+        if (pos == npos) {
             exists = false;
             return QoreValue();
         }
         exists = true;
 
-        qhlist_t::iterator li = i->second;
-        hm.erase(i);
-
-        QoreValue rv = (*li)->val;
-        internDeleteKey(li);
+        QoreValue rv = member_list[pos]->val;
+        internDeleteKey(pos);
 
         if (needs_scan(rv))
             incScanCount(-1);
@@ -308,11 +641,13 @@ public:
     }
 
     DLLLOCAL const char* getFirstKey() const  {
-        return member_list.empty() ? nullptr : member_list.front()->key.c_str();
+        HashMember* m = front();
+        return m ? m->getKey() : nullptr;
     }
 
     DLLLOCAL const char* getLastKey() const {
-        return member_list.empty() ? nullptr : member_list.back()->key.c_str();
+        HashMember* m = back();
+        return m ? m->getKey() : nullptr;
     }
 
     DLLLOCAL QoreListNode* getKeys() const;
@@ -324,6 +659,8 @@ public:
 
     DLLLOCAL int getLValue(const char* key, LValueHelper& lvh, bool for_remove, ExceptionSink* xsink);
 
+    DLLLOCAL int getLValue(const QoreHashKey& key, LValueHelper& lvh, bool for_remove, ExceptionSink* xsink);
+
     DLLLOCAL void getTypeName(QoreString& str) const {
         if (hashdecl)
             str.sprintf("hash<%s>", hashdecl->getName());
@@ -392,9 +729,13 @@ public:
             return h;
         }
         QoreHashNode* h = new QoreHashNode;
+        h->priv->member_list.reserve(len);
         // copy all members to new object
         for (auto& i : member_list) {
-            hash_assignment_priv ha(*h, i->key.c_str());
+            if (!i) {
+                continue;
+            }
+            hash_assignment_priv ha(*h->priv, h->priv->findCreateMember(*i));
             QoreValue v = copy_strip_complex_types(i->val);
 #ifdef DEBUG
             assert(ha.swap(v).isNothing());
@@ -407,9 +748,37 @@ public:
     }
 
     DLLLOCAL void copyIntern(qore_hash_private& h) const {
+        // members copied to an empty hash keep their order, so no lookups are needed and the index can be copied
+        if (!h.len && h.member_list.empty()) {
+            h.member_list.reserve(len);
+            for (auto& i : member_list) {
+                if (!i) {
+                    continue;
+                }
+                HashMember* m = HashMember::create(*i);
+                m->val = i->val.refSelf();
+                if (needs_scan(m->val)) {
+                    ++h.obj_count;
+                }
+                h.member_list.push_back(m);
+            }
+            h.len = h.member_list.size();
+            if (!hm.empty()) {
+                if (member_list.size() == len) {
+                    h.hm = hm;
+                } else {
+                    h.rebuildIndex();
+                }
+            }
+            return;
+        }
+        h.member_list.reserve(h.len + len);
         // copy all members to new object
         for (auto& i : member_list) {
-            hash_assignment_priv ha(h, i->key.c_str());
+            if (!i) {
+                continue;
+            }
+            hash_assignment_priv ha(h, h.findCreateMember(*i));
 #ifdef DEBUG
             assert(ha.swap(i->val.refSelf()).isNothing());
 #else
@@ -429,8 +798,12 @@ public:
     DLLLOCAL QoreHashNode* evalImpl(ExceptionSink* xsink) const {
         QoreHashNodeHolder h(getCopy(), xsink);
 
+        h->priv->member_list.reserve(len);
         for (qhlist_t::const_iterator i = member_list.begin(), e = member_list.end(); i != e; ++i) {
-            h->priv->setKeyValue((*i)->key, (*i)->val.refSelf(), xsink);
+            if (!*i) {
+                continue;
+            }
+            h->priv->setKeyValue(**i, (*i)->val.refSelf(), xsink);
             if (*xsink)
                 return nullptr;
         }
@@ -450,6 +823,12 @@ public:
         ha.assign(val, sdh, xsink);
     }
 
+    //! sets the value of the member with the same key as the given member; interned keys are shared
+    DLLLOCAL void setKeyValue(const HashMember& m, QoreValue val, SafeDerefHelper& sdh, ExceptionSink* xsink) {
+        hash_assignment_priv ha(*this, findCreateMember(m));
+        ha.assign(val, sdh, xsink);
+    }
+
     DLLLOCAL void setKeyValueIntern(const char* key, QoreValue v) {
         hash_assignment_priv ha(*this, key);
         // in case of assigning keys to an initialized hashdecl, the key may already have a value
@@ -467,6 +846,17 @@ public:
         ha.assign(val, xsink);
     }
 
+    //! sets the value of the member with the same key as the given member; interned keys are shared
+    DLLLOCAL void setKeyValue(const HashMember& m, QoreValue val, ExceptionSink* xsink) {
+        hash_assignment_priv ha(*this, findCreateMember(m));
+        ha.assign(val, xsink);
+    }
+
+    DLLLOCAL void setKeyValue(const QoreHashKey& key, QoreValue val, ExceptionSink* xsink) {
+        hash_assignment_priv ha(*this, findCreateMember(key));
+        ha.assign(val, xsink);
+    }
+
     DLLLOCAL void setKeyValue(const char* key, QoreValue val, qore_object_private* o, ExceptionSink* xsink) {
         hash_assignment_priv ha(*this, key, false, o);
         ha.assign(val, xsink);
@@ -475,18 +865,23 @@ public:
     DLLLOCAL bool derefImpl(ExceptionSink* xsink, bool reverse = false) {
         if (reverse) {
             for (qhlist_t::reverse_iterator i = member_list.rbegin(), e = member_list.rend(); i != e; ++i) {
-                (*i)->val.discard(xsink);
-                delete *i;
+                if (*i) {
+                    (*i)->val.discard(xsink);
+                    delete *i;
+                }
             }
         } else {
             for (qhlist_t::iterator i = member_list.begin(), e = member_list.end(); i != e; ++i) {
-                (*i)->val.discard(xsink);
-                delete *i;
+                if (*i) {
+                    (*i)->val.discard(xsink);
+                    delete *i;
+                }
             }
         }
 
         member_list.clear();
         hm.clear();
+        len = 0;
         obj_count = 0;
         valid = false;
         return true;
@@ -514,11 +909,11 @@ public:
     }
 
     DLLLOCAL size_t size() const {
-        return member_list.size();
+        return len;
     }
 
     DLLLOCAL bool empty() const {
-        return member_list.empty();
+        return !len;
     }
 
     DLLLOCAL void incScanCount(int dt) {
@@ -616,12 +1011,136 @@ public:
     }
 
     DLLLOCAL static QoreValue getFirstKeyValue(const QoreHashNode* h) {
-        return h->priv->member_list.empty() ? QoreValue() : h->priv->member_list.front()->val;
+        HashMember* m = h->priv->front();
+        return m ? m->val : QoreValue();
     }
 
     DLLLOCAL static QoreValue getLastKeyValue(const QoreHashNode* h) {
-        return h->priv->member_list.empty() ? QoreValue() : h->priv->member_list.back()->val;
+        HashMember* m = h->priv->back();
+        return m ? m->val : QoreValue();
+    }
+
+private:
+    template <typename T>
+    DLLLOCAL int getLValueIntern(const char* key, const T& k, LValueHelper& lvh, bool for_remove,
+            ExceptionSink* xsink);
+
+    // removes deleted members from the member list; invalidates member positions
+    DLLLOCAL void compact() {
+        size_t j = 0;
+        for (size_t i = 0, e = member_list.size(); i < e; ++i) {
+            if (member_list[i]) {
+                member_list[j++] = member_list[i];
+            }
+        }
+        member_list.resize(j);
+        ++generation;
+        if (!hm.empty()) {
+            rebuildIndex();
+        }
+    }
+
+    // rebuilds the index with a load factor of at most 1/4; hash codes are calculated if the hash was not indexed
+    DLLLOCAL void rebuildIndex() {
+        bool hashed = !hm.empty();
+        size_t size = 16;
+        while (size < len * 4) {
+            size <<= 1;
+        }
+        hm.assign(size, 0);
+        for (size_t i = 0, e = member_list.size(); i < e; ++i) {
+            HashMember* m = member_list[i];
+            if (!m) {
+                continue;
+            }
+            if (!hashed) {
+                if (!m->getInternedKey()) {
+                    m->hash = QoreHashKey::hashCode(m->getKey(), m->getKeyLen());
+                }
+            }
+            indexMember(i);
+        }
+    }
+
+    DLLLOCAL void indexMember(size_t pos) {
+        size_t mask = hm.size() - 1;
+        size_t i = member_list[pos]->hash & mask;
+        while (hm[i]) {
+            i = (i + 1) & mask;
+        }
+        hm[i] = pos + 1;
+    }
+
+    // removes the member from the index with backward-shift deletion so that no tombstones are needed in the index
+    DLLLOCAL void unindexMember(size_t pos) {
+        size_t mask = hm.size() - 1;
+        size_t i = member_list[pos]->hash & mask;
+        while (hm[i] != pos + 1) {
+            i = (i + 1) & mask;
+        }
+        size_t j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (!hm[j]) {
+                break;
+            }
+            size_t k = member_list[hm[j] - 1]->hash & mask;
+            // the entry stays if its home slot is cyclically in (i, j]
+            if (i <= j ? (i < k && k <= j) : (i < k || k <= j)) {
+                continue;
+            }
+            hm[i] = hm[j];
+            i = j;
+        }
+        hm[i] = 0;
     }
 };
 
+void qhi_priv::sync(const qore_hash_private& h) {
+    if (gen != h.generation) {
+        i = h.findPos(*m);
+        assert(i != qore_hash_private::npos);
+        gen = h.generation;
+    }
+}
+
+bool qhi_priv::set(const qore_hash_private& h, size_t pos) {
+    if (pos == qore_hash_private::npos) {
+        reset();
+        return false;
+    }
+    i = pos;
+    m = h.member_list[pos];
+    gen = h.generation;
+    val = true;
+    return true;
+}
+
+bool qhi_priv::next(const qore_hash_private& h) {
+    //printd(0, "qhi_priv::next() this: %p val: %d\n", this, val);
+    if (!val) {
+        return set(h, h.nextPos(0));
+    }
+    sync(h);
+    return set(h, h.nextPos(i + 1));
+}
+
+bool qhi_priv::prev(const qore_hash_private& h) {
+    if (!val) {
+        return set(h, h.prevPos(h.member_list.size()));
+    }
+    sync(h);
+    return set(h, h.prevPos(i));
+}
+
+bool qhi_priv::first(const qore_hash_private& h) {
+    sync(h);
+    return h.prevPos(i) == qore_hash_private::npos;
+}
+
+bool qhi_priv::last(const qore_hash_private& h) {
+    sync(h);
+    return h.nextPos(i + 1) == qore_hash_private::npos;
+}
+
 #endif
@@ -33,10 +33,14 @@
 
 #define _QORE_QOREHASHOBJECTDEREFERENCEOPERATORNODE_H
 
+class QoreHashKey;
+
 class QoreHashObjectDereferenceOperatorNode : public QoreBinaryOperatorNode<> {
 OP_COMMON
 protected:
     const QoreTypeInfo* typeInfo;
+    // the interned key if the right side is a string literal
+    const QoreHashKey* key = nullptr;
 
     DLLLOCAL QoreValue evalImpl(bool& needs_deref, ExceptionSink* xsink) const;
 
@@ -47,10 +51,17 @@ public:
             : QoreBinaryOperatorNode<>(loc, left, right), typeInfo(nullptr) {
     }
 
+    DLLLOCAL virtual ~QoreHashObjectDereferenceOperatorNode();
+
     DLLLOCAL virtual const QoreTypeInfo* getTypeInfo() const {
         return typeInfo;
     }
 
+    //! returns the interned key if the right side is a string literal, otherwise nullptr
+    DLLLOCAL const QoreHashKey* getInternedKey() const {
+        return key;
+    }
+
     DLLLOCAL virtual QoreOperatorNode* copyBackground(ExceptionSink* xsink) const {
         return copyBackgroundExplicit<QoreHashObjectDereferenceOperatorNode>(xsink);
     }
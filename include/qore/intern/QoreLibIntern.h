@@ -235,6 +235,8 @@ DLLLOCAL QoreValue q_call_static_method_args(QoreProgram* pgm, const QoreStringN
 // returns true if the node needs to be scanned for recursive references or not
 DLLLOCAL bool needs_scan(const AbstractQoreNode* n);
 DLLLOCAL bool needs_scan(const QoreValue& v);
+// returns true if the node is an object that is never scanned for recursive references because its class is cycle-free
+DLLLOCAL bool is_cycle_free_object(const AbstractQoreNode* n);
 // increments or decrements the object count depending on the sign of the argument (cannot be 0)
 DLLLOCAL void inc_container_obj(const AbstractQoreNode* n, int dt);
 
@@ -673,6 +675,8 @@ DLLLOCAL QoreValue copy_value_and_resolve_lvar_refs(const QoreValue& n, Exceptio
 
 DLLLOCAL void init_qore_types();
 DLLLOCAL void delete_qore_types();
+// releases the interned hash key table; keys that are still referenced are deleted with their last reference
+DLLLOCAL void delete_hash_keys();
 
 DLLLOCAL QoreListNode* stat_to_list(const struct stat& sbuf);
 DLLLOCAL QoreHashNode* stat_to_hash(const struct stat& sbuf, const TypedHashDecl* hd = hashdeclStatInfo);
@@ -1055,6 +1059,10 @@ DLLLOCAL extern ParseOptionMaps pomaps;
 DLLLOCAL extern QoreString YamlNullString;
 
 DLLLOCAL extern bool q_disable_gc;
+// recursive reference scans are made in a background thread
+DLLLOCAL extern bool q_background_gc;
+// threads used by the background operator are parked for reuse when they finish
+DLLLOCAL extern bool q_background_thread_pool;
 
 DLLLOCAL QoreValue qore_parse_get_define_value(const QoreProgramLocation* loc, const char* str, QoreString& arg,
     bool& ok);
@@ -42,10 +42,13 @@ private:
 
     DLLLOCAL void discardIntern() {
         if (needs_deref && val) {
-            val->deref(xsink);
+            derefIntern();
         }
     }
 
+    //! dereferences the list; unique lists are recycled in the current thread
+    DLLLOCAL void derefIntern();
+
     DLLLOCAL void evalIntern(const QoreListNode* exp) {
         if (exp) {
             val = exp->evalList(needs_deref, xsink);
@@ -188,12 +188,15 @@ public:
     // used for garbage collection
     mutable unsigned obj_count = 0;
 
-    mutable VRMutex gate;
+    // lock for synchronized methods; only allocated when first needed
+    mutable std::atomic<VRMutex*> gate = {nullptr};
 
     int scan_private_data = 0;
 
     bool system_object, in_destructor;
     bool recursive_ref_found;
+    // set if the object's class ensures that the object can never be part of a recursive reference
+    bool cycle_free;
 
     QoreObject* obj;
 
@@ -227,7 +230,7 @@ public:
     DLLLOCAL QoreHashNode* copyData(ExceptionSink* xsink, bool throw_exception = true) const;
 
     DLLLOCAL int getLValue(const char* key, LValueHelper& lvh, const qore_class_private* class_ctx, bool for_remove,
-            ExceptionSink* xsink);
+            ExceptionSink* xsink, const QoreMemberInfoCache* mcache = nullptr);
 
     DLLLOCAL QoreStringNode* firstKey(ExceptionSink* xsink) {
         // get the current class context
@@ -354,10 +357,12 @@ public:
 
     DLLLOCAL int checkMemberAccessGetTypeInfo(ExceptionSink* xsink, const char* mem,
             const qore_class_private* class_ctx, const qore_class_private*& member_class_ctx,
-            const QoreTypeInfo*& typeInfo) const {
+            const QoreTypeInfo*& typeInfo, const QoreMemberInfoCache* mcache = nullptr) const {
         assert(!member_class_ctx);
         const qore_class_private* theclass_priv = qore_class_private::get(*theclass);
-        const QoreMemberInfo* mi = theclass_priv->runtimeGetMemberInfo(mem, class_ctx);
+        const QoreMemberInfo* mi = mcache
+            ? mcache->get(theclass_priv, mem, class_ctx)
+            : theclass_priv->runtimeGetMemberInfo(mem, class_ctx);
         if (mi) {
             if (mi->access > Public && !class_ctx) {
                 doPrivateException(mem, xsink);
@@ -383,7 +388,8 @@ public:
 
     DLLLOCAL void takeMembers(QoreLValueGeneric& rv, LValueHelper& lvh, const QoreListNode* l);
 
-    DLLLOCAL QoreValue getReferencedMemberNoMethod(const char* mem, ExceptionSink* xsink) const;
+    DLLLOCAL QoreValue getReferencedMemberNoMethod(const char* mem, ExceptionSink* xsink,
+            const QoreMemberInfoCache* mcache = nullptr) const;
 
     // lock not held on entry
     DLLLOCAL void doDeleteIntern(ExceptionSink* xsink);
@@ -491,6 +497,8 @@ public:
 
     DLLLOCAL virtual bool scanMembers(RSetHelper& rsh);
 
+    DLLLOCAL virtual bool queueScan();
+
     // always called in the rsection lock
     DLLLOCAL virtual bool needsScan(bool scan_now) {
         assert(rml.hasRSectionLock());
@@ -498,7 +506,7 @@ public:
             getScanCount(), scan_private_data, scan_now);
 
         // the status cannot change while this lock is held
-        if ((!getScanCount() && !scan_private_data) || status != OS_OK) {
+        if (cycle_free || (!getScanCount() && !scan_private_data) || status != OS_OK) {
             return false;
         }
 
@@ -528,7 +536,7 @@ public:
         AutoLocker al(rlck);
         rref_wait = false;
         if (rref_waiting) {
-            rcond.broadcast();
+            rcondBroadcast();
         }
 
         return false;
@@ -595,7 +603,16 @@ public:
     }
 
     DLLLOCAL VRMutex* getGate() const {
-        return &gate;
+        VRMutex* rv = gate.load(std::memory_order_acquire);
+        if (!rv) {
+            VRMutex* g = new VRMutex;
+            if (gate.compare_exchange_strong(rv, g, std::memory_order_acq_rel)) {
+                return g;
+            }
+            // another thread allocated the lock first
+            delete g;
+        }
+        return rv;
     }
 
     /*
@@ -666,8 +683,9 @@ public:
     }
 
     DLLLOCAL static int getLValue(const QoreObject& obj, const char* key, LValueHelper& lvh,
-            const qore_class_private* class_ctx, bool for_remove, ExceptionSink* xsink) {
-        return obj.priv->getLValue(key, lvh, class_ctx, for_remove, xsink);
+            const qore_class_private* class_ctx, bool for_remove, ExceptionSink* xsink,
+            const QoreMemberInfoCache* mcache = nullptr) {
+        return obj.priv->getLValue(key, lvh, class_ctx, for_remove, xsink, mcache);
     }
 
     DLLLOCAL static QoreStringNode* firstKey(QoreObject* obj, ExceptionSink* xsink) {
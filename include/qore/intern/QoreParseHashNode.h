@@ -37,8 +37,12 @@
 
 #include <vector>
 #include <map>
+#include <memory>
 #include <string>
 
+class QoreHashKey;
+class QoreHashShape;
+
 DLLLOCAL QoreValue copy_value_and_resolve_lvar_refs(const QoreValue& n, ExceptionSink* xsink);
 
 class QoreParseHashNode : public ParseNode {
@@ -54,10 +58,13 @@ public:
     DLLLOCAL QoreParseHashNode(const QoreParseHashNode& old, ExceptionSink* xsink) :
         ParseNode(old.loc, NT_PARSE_HASH, true),
         lvec(old.lvec),
+        ikeys(old.ikeys),
+        shape(old.shape),
         kmap(old.kmap),
         vtype(old.vtype),
         typeInfo(old.typeInfo),
         curly(old.curly) {
+            refInternedKeys();
             keys.reserve(old.keys.size());
             values.reserve(old.values.size());
             for (auto& i : old.keys) {
@@ -80,6 +87,7 @@ public:
         }
         keys.clear();
         values.clear();
+        derefInternedKeys();
     }
 
     DLLLOCAL void add(QoreValue n, QoreValue v, const QoreProgramLocation* loc) {
@@ -151,9 +159,14 @@ public:
 protected:
     typedef std::map<std::string, bool> kmap_t;
     typedef std::vector<const QoreProgramLocation*> lvec_t;
+    typedef std::vector<const QoreHashKey*> ikvec_t;
     nvec_t keys, values;
     tvec_t vtypes;
     lvec_t lvec;
+    // interned keys for string literal keys, resolved when parsing
+    ikvec_t ikeys;
+    // the key layout of the hash if all keys are unique string literals
+    std::shared_ptr<const QoreHashShape> shape;
     // to detect duplicate values, only stored during parsing
     kmap_t kmap;
     // common value type, if any
@@ -171,6 +184,10 @@ protected:
 
     DLLLOCAL static void doDuplicateWarning(const QoreProgramLocation* newoc1, const char* key);
 
+    // references or releases the interned keys
+    DLLLOCAL void refInternedKeys() const;
+    DLLLOCAL void derefInternedKeys() const;
+
     DLLLOCAL void checkDup(const QoreProgramLocation* loc, const char* key) {
         std::string kstr(key);
         kmap_t::iterator i = kmap.lower_bound(kstr);
@@ -35,12 +35,24 @@
 
 #include <qore/QoreRWLock.h>
 
+#include <atomic>
+#include <vector>
+
 // FIXME: move to config.h or something like that
-// not more than this number of threads can be running at the same time
+// the default limit for the number of threads that can be running at the same time; can be changed at runtime
 #ifndef MAX_QORE_THREADS
 #define MAX_QORE_THREADS 0x2000
 #endif
 
+// the highest thread limit that can be set at runtime
+#ifndef QORE_THREAD_LIMIT_MAX
+#define QORE_THREAD_LIMIT_MAX 0x100000
+#endif
+
+// thread entries are allocated in chunks of this size (must be a power of 2) so that entries are never moved
+#define QORE_THREAD_ENTRY_CHUNK_BITS 8
+#define QORE_THREAD_ENTRY_CHUNK (1 << QORE_THREAD_ENTRY_CHUNK_BITS)
+
 class ThreadData;
 
 #define QTS_AVAIL    0
@@ -57,6 +69,8 @@ class ThreadData;
 #warning Darwin cannot support more than 2560 threads, MAX_QORE_THREADS set to 2560
 #undef MAX_QORE_THREADS
 #define MAX_QORE_THREADS 2560
+#undef QORE_THREAD_LIMIT_MAX
+#define QORE_THREAD_LIMIT_MAX 2560
 #endif
 
 class tid_node {
@@ -68,6 +82,14 @@ public:
    DLLLOCAL ~tid_node();
 };
 
+// runtime statistics counters kept for each thread; see q_inc_thread_stat()
+enum qore_thread_stat_e : unsigned {
+    QSTAT_VARIANT_CACHE_HITS = 0,
+    QSTAT_VARIANT_CACHE_MISSES,
+    QSTAT_OBJECT_SCANS_AVOIDED,
+    QSTAT_NUM
+};
+
 // this structure holds all thread data that can be addressed with the qore tid
 class ThreadEntry {
 public:
@@ -76,6 +98,8 @@ public:
     ThreadData* thread_data;
     unsigned char status;
     bool joined; // if set to true then pthread_detach should not be called on exit
+    // runtime statistics counters; only written by the thread using the TID, kept when the TID is released
+    std::atomic<int64> stats[QSTAT_NUM];
 
     DLLLOCAL void cleanup();
 
@@ -104,60 +128,43 @@ public:
     mutable QoreRWLock stack_lck;
 
     DLLLOCAL QoreThreadList() {
+        // the entry for TID 0 (the signal thread) must always be present
+        allocateChunk(0);
+    }
+
+    DLLLOCAL ~QoreThreadList() {
+        for (ThreadEntry* c : entry_chunks) {
+            delete [] c;
+        }
     }
 
     DLLLOCAL ThreadData* getThreadData(int tid) {
-        return entry[tid].active()
-            ? entry[tid].thread_data
+        return entry(tid).active()
+            ? entry(tid).thread_data
             : nullptr;
     }
 
-    DLLLOCAL int get(int status = QTS_NA, bool reuse_last = false) {
-        int tid = -1;
-        AutoLocker al(lck);
-
-        if (current_tid == MAX_QORE_THREADS) {
-            int i = last_tid + 1;
-            while (true) {
-                // never try to assign TID 0
-                if (i == MAX_QORE_THREADS) {
-                    if (!last_tid) {
-                        break;
-                    }
-                    i = 1;
-                }
-                assert(i && i < MAX_QORE_THREADS);
-                if (entry[i].available()) {
-                    tid = last_tid = i;
-                    break;
-                }
-                ++i;
-                if (i == last_tid) {
-                    break;
-                }
-            }
-            if (tid == -1) {
-                return -1;
-            }
-        } else if (reuse_last && current_tid && entry[current_tid - 1].available()) {
-            printd(5, "QoreThreadList::get() reusing TID %d\n", current_tid - 1);
-            // re-assign the last assigned TID
-            tid = current_tid - 1;
-        } else {
-            tid = current_tid++;
-        }
-        assert(entry[tid].available());
+    //! returns a new TID or -1 if the thread limit has been reached; O(1) except for the bitmap search
+    DLLLOCAL int get(int status = QTS_NA, bool reuse_last = false);
 
-        entry[tid].allocate(new tid_node(tid), status);
-        ++num_threads;
-        //printf("t%d cs=0\n", tid);
+    //! returns the current thread limit
+    DLLLOCAL int getThreadLimit() const {
+        return thread_limit;
+    }
 
-        return tid;
+    //! sets the thread limit for TIDs assigned after this call; returns -1 if the limit is out of range
+    DLLLOCAL int setThreadLimit(int limit) {
+        if (limit < 2 || limit > QORE_THREAD_LIMIT_MAX) {
+            return -1;
+        }
+        AutoLocker al(lck);
+        thread_limit = limit;
+        return 0;
     }
 
     DLLLOCAL int getSignalThreadEntry() {
         AutoLocker al(lck);
-        entry[0].allocate(0);
+        entry(0).allocate(0);
         return 0;
     }
 
@@ -168,7 +175,7 @@ public:
 
     DLLLOCAL int releaseReserved(int tid) {
         AutoLocker al(lck);
-        if (entry[tid].status != QTS_RESERVED) {
+        if (!hasEntry(tid) || entry(tid).status != QTS_RESERVED) {
             return -1;
         }
 
@@ -178,13 +185,19 @@ public:
 
     DLLLOCAL void activate(int tid, pthread_t ptid = pthread_self(), QoreProgram* p = nullptr, bool foreign = false) {
         AutoLocker al(lck);
-        entry[tid].activate(tid, ptid, p, foreign);
+        entry(tid).activate(tid, ptid, p, foreign);
+    }
+
+    //! marks the thread entry so that pthread_detach() is not called when the TID is released
+    DLLLOCAL void setDetached(int tid) {
+        AutoLocker al(lck);
+        entry(tid).joined = true;
     }
 
     DLLLOCAL void setStatus(int tid, int status) {
         AutoLocker al(lck);
-        assert(entry[tid].status != status);
-        entry[tid].status = status;
+        assert(entry(tid).status != status);
+        entry(tid).status = status;
     }
 
     DLLLOCAL void deleteData(int tid);
@@ -196,14 +209,23 @@ public:
     DLLLOCAL int activateReserved(int tid) {
         AutoLocker al(lck);
 
-        if (entry[tid].status != QTS_RESERVED) {
+        if (!hasEntry(tid) || entry(tid).status != QTS_RESERVED) {
             return -1;
         }
 
-        entry[tid].activate(tid, pthread_self(), nullptr, true);
+        entry(tid).activate(tid, pthread_self(), nullptr, true);
         return 0;
     }
 
+    //! increments a runtime statistics counter; must only be called by the thread using the given TID
+    DLLLOCAL void incStat(int tid, qore_thread_stat_e stat) {
+        std::atomic<int64>& c = entry(tid).stats[stat];
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    //! returns the sum of a runtime statistics counter over all thread entries
+    DLLLOCAL int64 getStat(qore_thread_stat_e stat) const;
+
     DLLLOCAL unsigned getNumThreads() const {
         return num_threads;
     }
@@ -225,31 +247,91 @@ protected:
     // lock for reading the thread list
     mutable QoreThreadLock lck;
     unsigned num_threads = 0;
-    ThreadEntry entry[MAX_QORE_THREADS];
+
+    // thread entries by TID in chunks of QORE_THREAD_ENTRY_CHUNK entries; chunks are allocated on demand
+    ThreadEntry* entry_chunks[(QORE_THREAD_LIMIT_MAX + QORE_THREAD_ENTRY_CHUNK - 1) / QORE_THREAD_ENTRY_CHUNK] = {};
+
+    // bitmap of released TIDs that can be reassigned, one bit per TID
+    std::vector<uint64_t> avail_bits;
+    // summary bitmap with one bit for each non-zero word in avail_bits
+    std::vector<uint64_t> avail_summary;
+
+    // the current thread limit; no TID greater than or equal to this value will be assigned
+    int thread_limit = MAX_QORE_THREADS;
 
     tid_node* tid_head = nullptr,
         * tid_tail = nullptr;
 
-    // current TID to be issued next
-    int current_tid = 1;
+    // current TID to be issued next; only modified with the lock held, but can be read without it
+    std::atomic<int> current_tid = {1};
 
     // last TID issued to avoid reusing the same TID over and over again
     int last_tid = 0;
 
     bool exiting = false;
 
+    DLLLOCAL ThreadEntry& entry(int tid) {
+        assert(tid >= 0 && tid < QORE_THREAD_LIMIT_MAX && entry_chunks[tid >> QORE_THREAD_ENTRY_CHUNK_BITS]);
+        return entry_chunks[tid >> QORE_THREAD_ENTRY_CHUNK_BITS][tid & (QORE_THREAD_ENTRY_CHUNK - 1)];
+    }
+
+    //! returns true if the TID has been assigned at least once
+    /** the entry's chunk is allocated before current_tid is updated, so this can be called without the lock
+    */
+    DLLLOCAL bool hasEntry(int tid) const {
+        return tid >= 0 && tid < current_tid.load(std::memory_order_acquire);
+    }
+
     DLLLOCAL void releaseIntern(int tid) {
         // NOTE: cannot safely call printd here, because normally the thread_data has been deleted
         //printf("DEBUG: ThreadList.releaseIntern() TID %d terminated\n", tid);
-        entry[tid].cleanup();
+        entry(tid).cleanup();
         if (tid) {
             --num_threads;
+            setAvail(tid);
         }
     }
+
+    //! marks a released TID as available for reassignment
+    DLLLOCAL void setAvail(int tid) {
+        unsigned w = tid >> 6;
+        if (!avail_bits[w]) {
+            avail_summary[w >> 6] |= (1ULL << (w & 63));
+        }
+        avail_bits[w] |= (1ULL << (tid & 63));
+    }
+
+    //! removes a TID from the available set
+    DLLLOCAL void clearAvail(int tid) {
+        unsigned w = tid >> 6;
+        avail_bits[w] &= ~(1ULL << (tid & 63));
+        if (!avail_bits[w]) {
+            avail_summary[w >> 6] &= ~(1ULL << (w & 63));
+        }
+    }
+
+    //! allocates the thread entries and available bitmap words for the given chunk
+    DLLLOCAL void allocateChunk(int c) {
+        assert(!entry_chunks[c]);
+        entry_chunks[c] = new ThreadEntry[QORE_THREAD_ENTRY_CHUNK]();
+        avail_bits.resize((c + 1) * (QORE_THREAD_ENTRY_CHUNK / 64));
+        avail_summary.resize((avail_bits.size() + 63) / 64);
+    }
+
+    //! returns the first available TID in [start, end) or -1 if none
+    DLLLOCAL int findAvail(int start, int end) const;
 };
 
 DLLLOCAL extern QoreThreadList thread_list;
 
+//! increments a runtime statistics counter for the current thread
+/** counters are not shared between threads, so updating them does not cause contention
+*/
+DLLLOCAL void q_inc_thread_stat(qore_thread_stat_e stat);
+
+//! returns the sum of a runtime statistics counter over all threads
+DLLLOCAL int64 q_get_thread_stat(qore_thread_stat_e stat);
+
 class QoreThreadListIterator : public AutoLocker {
 public:
     DLLLOCAL QoreThreadListIterator(bool access_stack = false) : AutoLocker(thread_list.lck),
@@ -270,7 +352,7 @@ public:
     DLLLOCAL bool next() {
         do {
             w = w ? w->next : thread_list.tid_head;
-        } while (w && (!w->tid || (thread_list.entry[w->tid].status != QTS_ACTIVE)));
+        } while (w && (!w->tid || (thread_list.entry(w->tid).status != QTS_ACTIVE)));
 
         return (bool)w;
     }
@@ -291,7 +373,7 @@ public:
     }
 
     DLLLOCAL ThreadData* get() {
-        if (tid >= 0 && tid < MAX_QORE_THREADS) {
+        if (thread_list.hasEntry(tid)) {
             return thread_list.getThreadData(tid);
         }
         return nullptr;
@@ -33,6 +33,8 @@
 
 #define QORE_TIMEZONEMANAGER_H
 
+#include "qore/intern/QoreDistributedRWLock.h"
+
 #include <cinttypes>
 #include <map>
 #include <string>
@@ -263,10 +265,10 @@ public:
 class QoreTimeZoneManager {
 protected:
     // read-write lock to manage real (non-offset) zone info objects
-    mutable QoreRWLock rwl;
+    mutable QoreDistributedRWLock rwl;
 
     // read-write lock to guard access to offset custom zone info objects
-    mutable QoreRWLock rwl_offset;
+    mutable QoreDistributedRWLock rwl_offset;
 
     // time zone info map (ex: "Europe/Prague" -> QoreZoneInfo*)
     typedef std::map<std::string, AbstractQoreZoneInfo* > tzmap_t;
@@ -326,7 +328,7 @@ public:
     }
 
     DLLLOCAL AbstractQoreZoneInfo* getZone(const char* name) {
-        QoreAutoRWReadLocker al(rwl);
+        QoreAutoDistributedRWReadLocker al(rwl);
         tzmap_t::iterator i = tzmap.find(name);
         return i == tzmap.end() ? 0 : i->second;
     }
@@ -39,6 +39,7 @@
 
 #include <set>
 #include <atomic>
+#include <deque>
 
 class RSet;
 class RSetHelper;
@@ -55,7 +56,8 @@ public:
     // ensures atomicity of robject reference counting and notification actions
     mutable QoreThreadLock rlck;
 
-    QoreCondition rcond; // condition variable (used with rlck)
+    // condition variable (used with rlck); only allocated when a thread first has to wait
+    QoreCondition* rcond = nullptr;
 
     int rscan = 0,          // TID flag for starting a recursive scan
         rcount = 0,         // the number of unique recursive references to this object
@@ -76,12 +78,30 @@ public:
         needs_is_valid : 1,  // do we need to call isValidImpl()
         rref_wait : 1;       // rset invalidation in progress
 
+    // queued for a scan by the background collector; protected by the collector's lock
+    bool scan_queued = false;
+
     DLLLOCAL RObject(std::atomic_int& n_refs, bool niv = false) :
         references(n_refs), deferred_scan(false), needs_is_valid(niv), rref_wait(false) {
     }
 
     DLLLOCAL virtual ~RObject();
 
+    // waits on the condition variable; rlck must be held
+    DLLLOCAL void rcondWait() {
+        if (!rcond) {
+            rcond = new QoreCondition;
+        }
+        rcond->wait(rlck);
+    }
+
+    // wakes up all threads waiting on the condition variable; rlck must be held
+    DLLLOCAL void rcondBroadcast() {
+        if (rcond) {
+            rcond->broadcast();
+        }
+    }
+
     DLLLOCAL void tRef() const {
 #ifdef QORE_DEBUG_OBJ_REFS
         printd(QORE_DEBUG_OBJ_REFS, "RObject::tRef() this: %p tref %d->%d\n", this, tRefs.reference_count(), tRefs.reference_count() + 1);
@@ -147,6 +167,13 @@ public:
     */
     DLLLOCAL virtual bool needsScan(bool scan_now) = 0;
 
+    // queues a scan of the object for the background collector
+    /** @return true if the scan was queued, false if the scan must be made immediately in the calling thread
+    */
+    DLLLOCAL virtual bool queueScan() {
+        return false;
+    }
+
     // deletes the object itself
     DLLLOCAL virtual void deleteObject() = 0;
 
@@ -399,6 +426,9 @@ protected:
 public:
     DLLLOCAL RSetHelper(RObject& obj);
 
+    // scans the given object immediately or queues the scan for the background collector if enabled
+    DLLLOCAL static void scan(RObject& obj);
+
     DLLLOCAL ~RSetHelper() {
         assert(ovec.empty());
         assert(!lcnt);
@@ -429,6 +459,61 @@ public:
 
 class qore_object_private;
 
+// number of buckets in the recursive reference scan time histogram
+#define QORE_RSET_SCAN_TIME_BUCKETS 6
+
+// background recursive reference collector; also maintains recursive reference scan statistics
+/** the collector thread is only started when scans are queued and terminates when the queue is empty; it processes
+    queued objects in time slices and pauses between slices to reduce contention with other threads
+
+    each collector thread is joined by the next collector thread started or by shutdown()
+*/
+class RSetCollector {
+public:
+    // queues a scan of the given object; a reference to the object is held until the scan has been made
+    /** @return true if the scan was queued, false if the scan must be made immediately in the calling thread
+    */
+    DLLLOCAL bool queueScan(qore_object_private& obj);
+
+    // records statistics for a completed scan
+    DLLLOCAL void recordScan(unsigned visited, int64 us);
+
+    // adds recursive reference scan statistics to the given hash
+    DLLLOCAL void getStatistics(QoreHashNode& h, ExceptionSink* xsink);
+
+    // stops queuing scans, waits for the queue to be processed, and joins the collector thread
+    /** called when the library is shut down; scans requested after this call are made in the calling thread
+    */
+    DLLLOCAL void shutdown();
+
+private:
+    // protects the queue and the collector thread state
+    QoreThreadLock m;
+    // objects queued for scanning
+    std::deque<qore_object_private*> queue;
+    // TID of the collector thread; 0 = not running
+    std::atomic<int> tid = {0};
+    // signaled when the collector thread has processed the queue
+    QoreCondition cond;
+    // the last collector thread started, if it has not been joined yet
+    pthread_t ptid;
+    bool joinable = false;
+    // set when the library is shut down
+    bool shutting_down = false;
+
+    // statistics
+    std::atomic<int64> scans = {0},
+        background_scans = {0},
+        objects_visited = {0};
+    std::atomic<int64> scan_times[QORE_RSET_SCAN_TIME_BUCKETS] = {};
+
+    DLLLOCAL void run(ExceptionSink* xsink);
+
+    DLLLOCAL static void runThread(ExceptionSink* xsink, void* arg);
+};
+
+DLLLOCAL extern RSetCollector qore_rset_collector;
+
 /** this class ensures that RObjects will not be deleted until all deref() calls are complete
  */
 class robject_dereference_helper {
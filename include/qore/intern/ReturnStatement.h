@@ -53,6 +53,14 @@ public:
         return true;
     }
 
+    DLLLOCAL virtual qore_stmt_op_e getExecOp(QoreValue& exp) const {
+        exp = this->exp;
+        return QSOP_RETURN;
+    }
+
+    // evaluates the return value; also used to execute the statement from pre-decoded statement blocks
+    DLLLOCAL static int execReturn(const QoreValue& exp, QoreValue& return_value, ExceptionSink* xsink);
+
 private:
     QoreValue exp;
 
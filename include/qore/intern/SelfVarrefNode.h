@@ -33,6 +33,44 @@
 
 #define _QORE_SELFVARREFNODE_H
 
+#include <atomic>
+
+class QoreMemberInfo;
+
+//! runtime cache of member declaration lookups for a member reference with a constant name
+/** caches the result of qore_class_private::runtimeGetMemberInfo() by the object's class and the class context
+*/
+class QoreMemberInfoCache {
+public:
+    DLLLOCAL QoreMemberInfoCache() {
+    }
+
+    //! returns the member declaration for the given member in the given class and class context, if any
+    DLLLOCAL const QoreMemberInfo* get(const qore_class_private* cls, const char* mem,
+            const qore_class_private* class_ctx) const;
+
+private:
+    static constexpr int QORE_MEMBER_CACHE_SIZE = 4;
+
+    struct entry_t {
+        std::atomic<const qore_class_private*> cls = {nullptr};
+        std::atomic<const qore_class_private*> class_ctx = {nullptr};
+        // nullptr if the member is not declared or not accessible
+        std::atomic<const QoreMemberInfo*> info = {nullptr};
+    };
+
+    mutable entry_t entries[QORE_MEMBER_CACHE_SIZE];
+    // sequence counter; odd while an update is in progress
+    mutable std::atomic<unsigned> seq = {0};
+    // the class epoch when the entries were added
+    mutable std::atomic<unsigned> epoch = {0};
+    // the next entry to write; only accessed by the thread holding the sequence counter
+    mutable int next = 0;
+
+    DLLLOCAL void add(const qore_class_private* cls, const qore_class_private* class_ctx,
+            const QoreMemberInfo* info) const;
+};
+
 class SelfVarrefNode : public ParseNode  {
 public:
     char* str;
@@ -61,8 +99,15 @@ public:
     // returns the string, caller owns the memory
     DLLLOCAL char* takeString();
 
+    // returns the member lookup cache for this reference
+    DLLLOCAL const QoreMemberInfoCache* getMemberCache() const {
+        return &member_cache;
+    }
+
 protected:
     const QoreTypeInfo* returnTypeInfo;
+    // caches member declaration lookups at runtime
+    QoreMemberInfoCache member_cache;
 
     DLLLOCAL virtual QoreValue evalImpl(bool& needs_deref, ExceptionSink* xsink) const;
 
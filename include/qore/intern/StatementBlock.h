@@ -171,6 +171,20 @@ public:
 protected:
     typedef safe_dslist<AbstractStatement*> statement_list_t;
     statement_list_t statement_list;
+    typedef std::vector<AbstractStatement*> statement_vec_t;
+    // contiguous copy of the statement list used for execution; set in parseCommit() and not used for top-level
+    // blocks, as statements can be added to them while they are being executed
+    statement_vec_t exec_list;
+    // a statement pre-decoded into an opcode and its expression
+    struct exec_op_t {
+        AbstractStatement* stmt;
+        QoreValue exp;
+        qore_stmt_op_e op;
+    };
+    typedef std::vector<exec_op_t> exec_code_t;
+    // pre-decoded statements executed instead of exec_list if the block was parsed with PO_EXEC_PREDECODED and no
+    // debugger is attached; set in parseCommit()
+    exec_code_t exec_code;
     block_list_t on_block_exit_list;
     LVList* lvars = nullptr;
 
@@ -181,6 +195,7 @@ protected:
     DLLLOCAL int parseCheckReturn();
 
     DLLLOCAL int execIntern(QoreValue& return_value, ExceptionSink* xsink);
+    DLLLOCAL int execPredecoded(QoreValue& return_value, ExceptionSink* xsink);
 
     DLLLOCAL StatementBlock(qore_program_private_base* p);
 };
@@ -32,8 +32,14 @@
 #ifndef _QORE_INTERN_THREADLOCALVARIABLEDATA_H
 #define _QORE_INTERN_THREADLOCALVARIABLEDATA_H
 
+#include <vector>
+#include <atomic>
+
 class ThreadLocalVariableData : public ThreadLocalData<LocalVarValue> {
 public:
+    DLLLOCAL ThreadLocalVariableData() : frame_block(curr) {
+    }
+
     // clears and marks all variables as finalized on the stack
     DLLLOCAL void finalize(SafeDerefHelper& sdh) {
         ThreadLocalVariableData::iterator i(curr);
@@ -88,15 +94,37 @@ public:
         --curr->pos;
     }
 
-    DLLLOCAL LocalVarValue* find(const char* id) {
+    //! finds the given variable using the frame-relative slot hint given; updates the hint if it's invalid
+    /** the slot is the offset of the variable from the start of the current frame; since variables are always
+        instantiated in the same order in a given frame, the slot will normally only have to be resolved once
+    */
+    DLLLOCAL LocalVarValue* find(const char* id, std::atomic<int>& slot) {
+        int s = slot.load(std::memory_order_relaxed);
+        if (s >= 0) {
+            LocalVarValue* var = getFrameSlot(s);
+            if (var && var->id == id && !var->frame_boundary) {
+                return var;
+            }
+        }
+
         Block* w = curr;
+        // set to false once the search passes the start of the current frame
+        bool in_frame = true;
         while (true) {
             int p = w->pos;
             while (p) {
                 --p;
                 LocalVarValue* var = &w->var[p];
-                if (var->id == id && !var->frame_boundary)
+                if (var->frame_boundary) {
+                    in_frame = false;
+                    continue;
+                }
+                if (var->id == id) {
+                    if (in_frame) {
+                        slot.store(getFrameOffset(w, p), std::memory_order_relaxed);
+                    }
                     return var;
+                }
             }
             w = w->prev;
 #ifdef DEBUG
@@ -114,7 +142,7 @@ public:
             assert(w);
         }
         // to avoid a warning on most compilers - note that this generates a warning on recent versions of aCC!
-        return 0;
+        return nullptr;
     }
 
     DLLLOCAL void pushFrameBoundary() {
@@ -122,6 +150,9 @@ public:
         //printd(5, "ThreadLocalVariableData::pushFrameBoundary(): fc:%d\n", frame_count);
         LocalVarValue* v = instantiate();
         v->setFrameBoundary();
+        frame_stack.push_back(frame_pos_t(frame_block, frame_pos));
+        frame_block = curr;
+        frame_pos = curr->pos;
     }
 
     DLLLOCAL void popFrameBoundary() {
@@ -131,6 +162,10 @@ public:
         uninstantiateIntern();
         assert(curr->var[curr->pos].frame_boundary);
         curr->var[curr->pos].frame_boundary = false;
+        assert(!frame_stack.empty());
+        frame_block = frame_stack.back().first;
+        frame_pos = frame_stack.back().second;
+        frame_stack.pop_back();
     }
 
     DLLLOCAL int getFrame(int frame, Block*& w, int& p);
@@ -139,6 +174,44 @@ public:
 
     // returns 0 = OK, 1 = no such variable, -1 exception setting variable
     DLLLOCAL int setVarValue(int frame, const char* name, const QoreValue& val, ExceptionSink* xsink);
+
+private:
+    typedef std::pair<Block*, int> frame_pos_t;
+    typedef std::vector<frame_pos_t> frame_stack_t;
+
+    // the block and position of the first variable in the current frame
+    Block* frame_block;
+    int frame_pos = 0;
+    // saved frame start positions for outer frames
+    frame_stack_t frame_stack;
+
+    // returns the variable at the given offset in the current frame, if instantiated, otherwise nullptr
+    DLLLOCAL LocalVarValue* getFrameSlot(int slot) const {
+        Block* w = frame_block;
+        int p = frame_pos + slot;
+        while (p >= QORE_THREAD_STACK_BLOCK) {
+            if (w == curr) {
+                return nullptr;
+            }
+            w = w->next;
+            p -= QORE_THREAD_STACK_BLOCK;
+        }
+        if (w == curr && p >= curr->pos) {
+            return nullptr;
+        }
+        return &w->var[p];
+    }
+
+    // returns the offset of the given position in the current frame
+    DLLLOCAL int getFrameOffset(Block* w, int p) const {
+        int offset = p - frame_pos;
+        for (Block* b = frame_block; b != w; b = b->next) {
+            assert(b);
+            offset += QORE_THREAD_STACK_BLOCK;
+        }
+        assert(offset >= 0);
+        return offset;
+    }
 };
 
 #endif
@@ -32,6 +32,8 @@
 
 #define QTP_DEFAULT_RELEASE_MS 5000
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <qore/qlist>
 
@@ -41,23 +43,116 @@ class ThreadPoolThread;
 typedef std::deque<ThreadTask*> taskq_t;
 typedef qlist<ThreadPoolThread*> tplist_t;
 
+DLLEXPORT extern QoreClass* QC_THREADPOOLFUTURE;
+
+//! holds the result of a task submitted with ThreadPool::submitFuture()
+class ThreadTaskFuture : public AbstractPrivateData {
+public:
+    DLLLOCAL ThreadTaskFuture() {
+    }
+
+    DLLLOCAL virtual void deref(ExceptionSink* xsink) {
+        if (ROdereference()) {
+            rv.discard(xsink);
+            if (ex) {
+                ex->deref(xsink);
+            }
+            delete this;
+        }
+    }
+
+    //! sets the result of the task; takes over the reference
+    DLLLOCAL void setResult(QoreValue v) {
+        AutoLocker al(m);
+        assert(!done);
+        rv = v;
+        done = true;
+        cond.broadcast();
+    }
+
+    //! sets the exception raised by the task
+    DLLLOCAL void setException(ExceptionSink& xs) {
+        QoreHashNode* h = xs.getExceptionInfo();
+        xs.clear();
+        AutoLocker al(m);
+        assert(!done);
+        ex = h;
+        done = true;
+        cond.broadcast();
+    }
+
+    DLLLOCAL void setCanceled() {
+        AutoLocker al(m);
+        assert(!done);
+        canceled = true;
+        done = true;
+        cond.broadcast();
+    }
+
+    //! returns true if the task has completed or was canceled
+    DLLLOCAL bool isDone() {
+        AutoLocker al(m);
+        return done;
+    }
+
+    DLLLOCAL bool isCanceled() {
+        AutoLocker al(m);
+        return canceled;
+    }
+
+    //! waits for the task to complete; returns 0 if complete, -1 for timeout
+    DLLLOCAL int wait(int timeout_ms) {
+        AutoLocker al(m);
+        return waitUnlocked(timeout_ms);
+    }
+
+    //! returns the result of the task or rethrows the exception raised by the task
+    DLLLOCAL QoreValue get(int timeout_ms, ExceptionSink* xsink);
+
+private:
+    QoreThreadLock m;
+    QoreCondition cond;
+    QoreValue rv;
+    QoreHashNode* ex = nullptr;
+    bool done = false,
+        canceled = false;
+
+    DLLLOCAL int waitUnlocked(int timeout_ms) {
+        while (!done) {
+            if (timeout_ms) {
+                if (cond.wait(m, timeout_ms)) {
+                    return done ? 0 : -1;
+                }
+            } else {
+                cond.wait(m);
+            }
+        }
+        return 0;
+    }
+};
+
 class ThreadTask {
 public:
-    DLLLOCAL ThreadTask(ResolvedCallReferenceNode* c, ResolvedCallReferenceNode* cc) : code(c), cancelCode(cc) {
+    DLLLOCAL ThreadTask(ResolvedCallReferenceNode* c, ResolvedCallReferenceNode* cc,
+            ThreadTaskFuture* f = nullptr) : code(c), cancelCode(cc), future(f) {
     }
 
     DLLLOCAL ~ThreadTask() {
         assert(!code);
         assert(!cancelCode);
+        assert(!future);
     }
 
     DLLLOCAL void del(ExceptionSink* xsink) {
         code->deref(xsink);
         if (cancelCode)
             cancelCode->deref(xsink);
+        if (future)
+            future->deref(xsink);
 #ifdef DEBUG
         code = nullptr;
         cancelCode = nullptr;
+        future = nullptr;
 #endif
         delete this;
     }
@@ -66,14 +161,34 @@ public:
         return code->execValue(0, xsink);
     }
 
+    //! runs the task and posts the result to the future, if any
+    DLLLOCAL void exec(ExceptionSink* xsink) {
+        if (!future) {
+            run(xsink).discard(xsink);
+            return;
+        }
+
+        ExceptionSink xs;
+        QoreValue v = run(&xs);
+        if (xs) {
+            v.discard(&xs);
+            future->setException(xs);
+        } else {
+            future->setResult(v);
+        }
+    }
+
     DLLLOCAL void cancel(ExceptionSink* xsink) {
         if (cancelCode)
             cancelCode->execValue(0, xsink).discard(xsink);
+        if (future)
+            future->setCanceled();
     }
 
 protected:
     ResolvedCallReferenceNode* code;
     ResolvedCallReferenceNode* cancelCode;
+    ThreadTaskFuture* future;
 };
 
 class ThreadTaskHolder {
@@ -104,7 +219,10 @@ class ThreadPoolThread {
 protected:
     int id;
     ThreadPool& tp;
-    ThreadTask* task = nullptr;
+    // local task queue; the thread executes tasks from the front, other threads steal from the back
+    taskq_t lq;
+    // number of tasks in the local queue; can be read without the lock
+    std::atomic<unsigned> queued = {0};
     QoreCondition c,
         *stopCond = nullptr;
     QoreThreadLock m;
@@ -119,7 +237,7 @@ public:
 
     DLLLOCAL ~ThreadPoolThread() {
         delete stopCond;
-        assert(!task);
+        assert(lq.empty());
     }
 
     DLLLOCAL void setPos(tplist_t::iterator p) {
@@ -168,9 +286,38 @@ public:
     DLLLOCAL void submit(ThreadTask* t) {
         AutoLocker al(m);
         assert(!stopflag);
-        assert(!task);
-        task = t;
-        c.signal();
+        lq.push_back(t);
+        if (!queued.fetch_add(1, std::memory_order_relaxed))
+            c.signal();
+    }
+
+    //! appends the given tasks to the local queue with a single wakeup
+    DLLLOCAL void submitBatch(taskq_t::iterator b, taskq_t::iterator e) {
+        assert(b != e);
+        AutoLocker al(m);
+        assert(!stopflag);
+        unsigned n = e - b;
+        lq.insert(lq.end(), b, e);
+        if (!queued.fetch_add(n, std::memory_order_relaxed))
+            c.signal();
+    }
+
+    //! moves up to half of the tasks waiting in the local queue to the given queue; returns the number of tasks moved
+    /** called with the ThreadPool lock held
+     */
+    DLLLOCAL unsigned steal(taskq_t& dest) {
+        AutoLocker al(m);
+        if (stopflag || lq.empty())
+            return 0;
+        unsigned n = (lq.size() + 1) / 2;
+        dest.insert(dest.end(), lq.end() - n, lq.end());
+        lq.erase(lq.end() - n, lq.end());
+        queued.fetch_sub(n, std::memory_order_relaxed);
+        return n;
+    }
+
+    DLLLOCAL unsigned getQueued() const {
+        return queued.load(std::memory_order_relaxed);
     }
 
     DLLLOCAL int getId() const {
@@ -241,6 +388,53 @@ protected:
         return 0;
     }
 
+    //! gives a share of the master queue or tasks stolen from the busiest worker to the given thread
+    /** @return 0 if tasks were placed in the thread's local queue, -1 if no tasks are available
+    */
+    DLLLOCAL int takeTasksUnlocked(ThreadPoolThread* tpt) {
+        if (!q.empty()) {
+            size_t n = (q.size() + ah.size() - 1) / ah.size();
+            tpt->submitBatch(q.begin(), q.begin() + n);
+            q.erase(q.begin(), q.begin() + n);
+            return 0;
+        }
+
+        ThreadPoolThread* victim = nullptr;
+        unsigned max_queued = 0;
+        for (auto& i : ah) {
+            unsigned n = i->getQueued();
+            if (n > max_queued) {
+                max_queued = n;
+                victim = i;
+            }
+        }
+
+        if (victim) {
+            taskq_t tq;
+            if (victim->steal(tq)) {
+                tpt->submitBatch(tq.begin(), tq.end());
+                return 0;
+            }
+        }
+
+        return -1;
+    }
+
+    //! distributes the master queue over the local queues of the running threads
+    /** called when all threads are busy and no more threads can be started
+    */
+    DLLLOCAL void distributeUnlocked() {
+        assert(!ah.empty());
+        size_t n = (q.size() + ah.size() - 1) / ah.size();
+        for (auto& i : ah) {
+            if (q.empty())
+                break;
+            size_t c = std::min(n, q.size());
+            i->submitBatch(q.begin(), q.begin() + c);
+            q.erase(q.begin(), q.begin() + c);
+        }
+    }
+
     DLLLOCAL ThreadPoolThread* getThreadUnlocked(ExceptionSink* xsink) {
         assert(xsink);
         while (!stopflag && fh.empty() && max && (int)ah.size() == max) {
@@ -340,9 +534,10 @@ public:
         return 0;
     }
 
-    DLLLOCAL int submit(ResolvedCallReferenceNode* c, ResolvedCallReferenceNode* cc, ExceptionSink* xsink) {
+    DLLLOCAL int submit(ResolvedCallReferenceNode* c, ResolvedCallReferenceNode* cc, ExceptionSink* xsink,
+            ThreadTaskFuture* f = nullptr) {
         // optimistically create the task object outside the lock
-        ThreadTaskHolder task(new ThreadTask(c, cc), xsink);
+        ThreadTaskHolder task(new ThreadTask(c, cc, f), xsink);
 
         AutoLocker al(m);
         if (checkStopUnlocked("submit", xsink))
@@ -355,12 +550,38 @@ public:
         return 0;
     }
 
+    //! submits all tasks in the queue with a single wakeup of the ThreadPool's worker thread
+    /** the tasks are deleted if they cannot be submitted
+     */
+    DLLLOCAL int submitBatch(taskq_t& tq, ExceptionSink* xsink) {
+        {
+            AutoLocker al(m);
+            if (!checkStopUnlocked("submitBatch", xsink)) {
+                if (q.empty())
+                    cond.signal();
+                q.insert(q.end(), tq.begin(), tq.end());
+                tq.clear();
+                return 0;
+            }
+        }
+
+        for (auto& i : tq) {
+            i->del(xsink);
+        }
+        tq.clear();
+        return -1;
+    }
+
     DLLLOCAL void threadCounts(int& idle, int& running) {
         AutoLocker al(m);
         idle = fh.size();
         running = ah.size();
     }
 
+    //! called by a worker thread without its lock held when its local queue is empty
+    /** @return 1 if tasks have been placed in the thread's local queue, 0 if the thread should wait for tasks, -1 if
+        the thread should terminate
+    */
     DLLLOCAL int done(ThreadPoolThread* tpt) {
         {
             AutoLocker al(m);
@@ -369,6 +590,12 @@ public:
                 return 0;
             }
 
+            // tasks may have been distributed to the thread in the meantime; otherwise take tasks from the master
+            // queue or steal them from another worker before returning the thread to the pool
+            if (tpt->getQueued() || !takeTasksUnlocked(tpt)) {
+                return 1;
+            }
+
             tplist_t::iterator i = tpt->getPos();
             ah.erase(i);
 
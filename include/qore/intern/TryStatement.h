@@ -55,6 +55,8 @@ private:
     const QoreTypeInfo* typeInfo;
     QoreParseTypeInfo* parseTypeInfo;
     const QoreProgramLocation* loc;
+    // true if the exception call stack can be accessed through the catch parameter
+    bool needs_callstack = true;
 
     DLLLOCAL virtual int execImpl(QoreValue& return_value, ExceptionSink* xsink);
     DLLLOCAL virtual int parseInitImpl(QoreParseContext& parse_context);
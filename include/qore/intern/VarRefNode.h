@@ -60,6 +60,7 @@ public:
     DLLLOCAL VarRefNode(const QoreProgramLocation* loc, char* n, LocalVar* n_id, bool in_closure)
             : ParseNode(loc, NT_VARREF, true, false), name(n), new_decl(false), explicit_scope(false) {
         ref.id = n_id;
+        n_id->parseRef();
         if (in_closure) {
             setClosureIntern();
         } else {
@@ -60,6 +60,7 @@ class ScopedObjectCallNode;
 class QoreSquareBracketsOperatorNode;
 class QoreSquareBracketsRangeOperatorNode;
 class QoreHashObjectDereferenceOperatorNode;
+class QoreHashKey;
 
 union qore_gvar_ref_u {
     bool b;
@@ -227,6 +228,9 @@ public:
 
     DLLLOCAL QoreValue eval() const;
 
+    //! tries to read a scalar value without taking the lock; returns true if successful
+    DLLLOCAL bool tryOptimisticEval(QoreValue& rv) const;
+
     DLLLOCAL void doDoubleDeclarationError(const QoreProgramLocation* loc) {
         // make sure types are identical or throw an exception
         if (parseTypeInfo) {
@@ -342,9 +346,10 @@ protected:
     }
 
     DLLLOCAL int doListLValue(const QoreSquareBracketsOperatorNode* op, bool for_remove);
-    DLLLOCAL int doHashLValue(qore_type_t t, const char* mem, bool for_remove);
+    DLLLOCAL int doHashLValue(qore_type_t t, const char* mem, bool for_remove, const QoreHashKey* key = nullptr);
     DLLLOCAL int doObjLValue(QoreObject* o, const char* mem, bool for_remove);
     DLLLOCAL int doHashObjLValue(const QoreHashObjectDereferenceOperatorNode* op, bool for_remove);
+    DLLLOCAL int doHashObjLValue(const QoreValue& left, const char* mem, const QoreHashKey* key, bool for_remove);
 
     DLLLOCAL int makeIntQv(const char* desc);
     DLLLOCAL int makeIntVal(const char* desc);
@@ -32,18 +32,55 @@
 #ifndef _QORE_QORELISTPRIVATE_H
 #define _QORE_QORELISTPRIVATE_H
 
+#include <atomic>
 #include <cstring>
 
 typedef ReferenceHolder<QoreListNode> safe_qorelist_t;
 
 #define LIST_PAD   15
 
+// minimum number of elements for list copies to share the element storage of the original list
+#ifndef QORE_LIST_SHARE_MIN
+#define QORE_LIST_SHARE_MIN 32
+#endif
+
+// packed elements are stored as int64 or double values, which have the same size; bool elements are stored as int64
+// values 0 or 1
+static_assert(sizeof(int64) == sizeof(double), "packed list elements must have the same size");
+
+//! element storage shared between copies of a list until the storage is modified
+struct qore_list_buffer {
+    // QoreValue entries or packed elements
+    void* data;
+    // capacity in elements
+    size_t allocated;
+    // number of elements held by the buffer; a list can only append to the buffer if its length is equal
+    std::atomic<size_t> used;
+    // NT_INT, NT_FLOAT or NT_BOOLEAN if the elements are packed
+    qore_type_t packed_type;
+    // the number of lists sharing the buffer
+    QoreReferenceCounter refs;
+
+    DLLLOCAL qore_list_buffer(void* data, size_t allocated, size_t used, qore_type_t packed_type)
+            : data(data), allocated(allocated), used(used), packed_type(packed_type) {
+    }
+
+    //! releases a reference; the last reference dereferences the elements and frees the storage
+    DLLLOCAL void deref(ExceptionSink* xsink);
+};
+
 struct qore_list_private {
     QoreValue* entry = nullptr;
+    // unboxed element storage used instead of "entry" when "packed_type" is set
+    void* packed = nullptr;
+    // set if "entry" or "packed" points to storage shared with other lists; only read or appended to in place
+    mutable std::atomic<qore_list_buffer*> shared = {nullptr};
     size_t length = 0;
     size_t allocated = 0;
     unsigned obj_count = 0;
     const QoreTypeInfo* complexTypeInfo = nullptr;
+    // NT_INT, NT_FLOAT or NT_BOOLEAN if the elements are stored unboxed in "packed"
+    qore_type_t packed_type = NT_NOTHING;
     QoreReferenceCounter weakRefs;
     bool finalized : 1;
     bool vlist : 1;
@@ -55,11 +92,236 @@ struct qore_list_private {
     DLLLOCAL ~qore_list_private() {
         assert(!length);
 
-        if (entry) {
+        if (shared) {
+            releaseShared(nullptr);
+        } else {
+            if (entry) {
+                free(entry);
+            }
+            if (packed) {
+                free(packed);
+            }
+        }
+    }
+
+    //! returns the element at the given offset; no reference is added
+    DLLLOCAL QoreValue getValue(size_t i) const {
+        assert(i < length);
+        switch (packed_type) {
+            case NT_INT:
+                return static_cast<const int64*>(packed)[i];
+            case NT_FLOAT:
+                return static_cast<const double*>(packed)[i];
+            case NT_BOOLEAN:
+                return static_cast<const int64*>(packed)[i] != 0;
+            default:
+                break;
+        }
+        return entry[i];
+    }
+
+    //! returns the packed int64 values; also used for bool elements, which are stored as 0 or 1
+    DLLLOCAL int64* getPackedInts() const {
+        assert(packed_type == NT_INT || packed_type == NT_BOOLEAN);
+        return static_cast<int64*>(packed);
+    }
+
+    DLLLOCAL double* getPackedFloats() const {
+        assert(packed_type == NT_FLOAT);
+        return static_cast<double*>(packed);
+    }
+
+    //! returns the type of element that can be stored unboxed for the list's type, if any
+    /** only lists with an element type of exactly int, float or bool use packed storage
+    */
+    DLLLOCAL qore_type_t getPackableType() const {
+        const QoreTypeInfo* vti = getValueTypeInfo();
+        if (vti == bigIntTypeInfo) {
+            return NT_INT;
+        }
+        if (vti == floatTypeInfo) {
+            return NT_FLOAT;
+        }
+        if (vti == boolTypeInfo) {
+            return NT_BOOLEAN;
+        }
+        return NT_NOTHING;
+    }
+
+    //! stores a value of the packed type at the given offset
+    DLLLOCAL void setPacked(size_t i, const QoreValue val) {
+        assert(val.getType() == packed_type);
+        switch (packed_type) {
+            case NT_INT:
+                getPackedInts()[i] = val.v.i;
+                break;
+            case NT_FLOAT:
+                getPackedFloats()[i] = val.v.f;
+                break;
+            default:
+                assert(packed_type == NT_BOOLEAN);
+                getPackedInts()[i] = val.v.b ? 1 : 0;
+                break;
+        }
+    }
+
+    //! switches an empty list to packed storage for elements of the given type
+    DLLLOCAL void initPacked(qore_type_t t) {
+        assert(!length);
+        assert(!packed_type);
+        assert(t == NT_INT || t == NT_FLOAT || t == NT_BOOLEAN);
+        if (shared) {
+            releaseShared(nullptr);
+            allocated = 0;
+        } else if (entry) {
             free(entry);
         }
+        entry = nullptr;
+        packed_type = t;
+        // keep any capacity already reserved
+        if (allocated) {
+            packed = malloc(sizeof(int64) * allocated);
+        }
+    }
+
+    //! appends a value of the packed type
+    DLLLOCAL void pushPacked(const QoreValue val) {
+        assert(val.getType() == packed_type);
+        if (shared) {
+            if (appendShared(val)) {
+                return;
+            }
+            detach(length + 1);
+        }
+        if (length == allocated) {
+            reserve(length + 1);
+        }
+        setPacked(length, val);
+        ++length;
+    }
+
+    //! returns the buffer holding the list's elements, converting the list's own storage to a shared buffer
+    /** the list's element pointers do not change, so concurrent readers are not affected
+    */
+    DLLLOCAL qore_list_buffer* getSharedBuffer() const {
+        qore_list_buffer* b = shared;
+        if (b) {
+            return b;
+        }
+        b = new qore_list_buffer(packed_type ? packed : static_cast<void*>(entry), allocated, length, packed_type);
+        qore_list_buffer* old = nullptr;
+        if (!shared.compare_exchange_strong(old, b)) {
+            // another thread shared the storage first
+            b->data = nullptr;
+            delete b;
+            return old;
+        }
+        return b;
+    }
+
+    //! appends a value to the shared buffer in place if no other list has appended to it and it has room
+    /** values that need scanning are never stored in shared buffers
+    */
+    DLLLOCAL bool appendShared(const QoreValue val) {
+        qore_list_buffer* b = shared;
+        assert(b);
+        size_t n = length;
+        if (n == b->allocated || needs_scan(val) || !b->used.compare_exchange_strong(n, length + 1)) {
+            return false;
+        }
+        // the slot now belongs to this list
+        if (packed_type) {
+            setPacked(length, val);
+        } else {
+            new (&entry[length]) QoreValue(val);
+        }
+        ++length;
+        return true;
+    }
+
+    //! releases the list's reference to its shared buffer; the element pointers must be reset by the caller
+    DLLLOCAL void releaseShared(ExceptionSink* xsink) {
+        qore_list_buffer* b = shared;
+        assert(b);
+        shared = nullptr;
+        b->deref(xsink);
+    }
+
+    //! gives the list its own storage with room for at least the given number of elements if it is shared
+    /** must be called before elements are modified in place; called only when the caller has exclusive access to
+        the list
+    */
+    DLLLOCAL void detach(size_t num = 0);
+
+    //! ensures that the list has boxed entries that can be modified in place
+    DLLLOCAL void makeWritable() {
+        if (packed_type) {
+            unpack();
+        } else if (shared) {
+            detach();
+        }
     }
 
+    //! converts packed storage to boxed QoreValue entries
+    /** must be called before any reference to an entry is returned or before any value of another type is stored;
+        called only when the caller has exclusive access to the list
+    */
+    DLLLOCAL void unpack() {
+        if (!packed_type) {
+            return;
+        }
+        assert(!entry);
+        if (allocated) {
+#pragma GCC diagnostic ignored "-Wclass-memaccess"
+            entry = (QoreValue*)malloc(sizeof(QoreValue) * allocated);
+#pragma GCC diagnostic pop
+            for (size_t i = 0; i < length; ++i) {
+                new (&entry[i]) QoreValue(getValue(i));
+            }
+        }
+        // the new entries are never shared
+        if (shared) {
+            releaseShared(nullptr);
+        } else if (packed) {
+            free(packed);
+        }
+        packed = nullptr;
+        packed_type = NT_NOTHING;
+    }
+
+    //! converts boxed entries to packed storage if the list's type allows it and all elements have the packed type
+    /** used when the type of a list is set after its elements have been added; called only when the caller has
+        exclusive access to the list
+    */
+    DLLLOCAL void pack() {
+        qore_type_t t;
+        if (packed_type || !length || !(t = getPackableType())) {
+            return;
+        }
+        for (size_t i = 0; i < length; ++i) {
+            if (entry[i].getType() != t) {
+                return;
+            }
+        }
+        void* p = malloc(sizeof(int64) * allocated);
+        QoreValue* e = entry;
+        packed = p;
+        packed_type = t;
+        for (size_t i = 0; i < length; ++i) {
+            setPacked(i, e[i]);
+        }
+        // the packed storage is never shared
+        if (shared) {
+            releaseShared(nullptr);
+        } else {
+            free(e);
+        }
+        entry = nullptr;
+    }
+
+    //! sorts packed elements in place with the default comparison; returns false if the list must be sorted boxed
+    DLLLOCAL bool sortPacked(bool ascending);
+
     DLLLOCAL const QoreTypeInfo* getValueTypeInfo() const {
         return complexTypeInfo ? QoreTypeInfo::getComplexListValueType(complexTypeInfo) : nullptr;
     }
@@ -137,15 +399,45 @@ struct qore_list_private {
         QoreListNode* l = new QoreListNode;
         l->priv->reserve(length);
         for (size_t i = 0; i < length; ++i) {
-            l->priv->pushIntern(copy_strip_complex_types(entry[i]));
+            l->priv->pushIntern(copy_strip_complex_types(getValue(i)));
         }
         return l;
     }
 
     DLLLOCAL void copyIntern(qore_list_private& l) const {
+        // larger lists share their storage with the copy until either list is modified; lists with elements that
+        // need scanning for recursive references are always copied
+        if (length >= QORE_LIST_SHARE_MIN && !obj_count && !l.length && !l.packed_type && !l.shared) {
+            qore_list_buffer* b = getSharedBuffer();
+            b->refs.ROreference();
+            if (l.entry) {
+                free(l.entry);
+                l.entry = nullptr;
+            }
+            l.shared = b;
+            l.packed_type = packed_type;
+            if (packed_type) {
+                l.packed = b->data;
+            } else {
+                l.entry = static_cast<QoreValue*>(b->data);
+            }
+            l.allocated = b->allocated;
+            l.length = length;
+            return;
+        }
+        // packed elements can be copied directly
+        if (packed_type && !l.length && !l.packed_type) {
+            l.initPacked(packed_type);
+            l.reserve(length);
+            if (length) {
+                memcpy(l.packed, packed, sizeof(int64) * length);
+            }
+            l.length = length;
+            return;
+        }
         l.reserve(length);
         for (size_t i = 0; i < length; ++i) {
-            l.pushIntern(entry[i].refSelf());
+            l.pushIntern(getValue(i).refSelf());
         }
     }
 
@@ -253,7 +545,7 @@ struct qore_list_private {
     // fast merge without type conversion; performs type stripping if necessary
     DLLLOCAL static QoreListNode* mergeWithoutTypeConversion(ReferenceHolder<QoreListNode>& rv, const qore_list_private& list) {
         for (size_t i = 0; i < list.length; ++i) {
-            QoreValue v = list.entry[i];
+            QoreValue v = list.getValue(i);
             if (!rv->priv->complexTypeInfo) {
                 v = copy_strip_complex_types(v);
             } else {
@@ -266,6 +558,23 @@ struct qore_list_private {
     }
 
     DLLLOCAL void pushIntern(QoreValue val) {
+        qore_type_t t;
+        if (packed_type) {
+            if (val.getType() == packed_type) {
+                pushPacked(val);
+                return;
+            }
+            unpack();
+        } else if (!length && (t = getPackableType()) && val.getType() == t) {
+            initPacked(t);
+            pushPacked(val);
+            return;
+        } else if (shared) {
+            if (appendShared(val)) {
+                return;
+            }
+            detach(length + 1);
+        }
         getEntryReference(length) = val;
         if (needs_scan(val)) {
             incScanCount(1);
@@ -294,6 +603,7 @@ struct qore_list_private {
 
     QoreValue spliceSingle(size_t offset) {
         assert(offset < length);
+        makeWritable();
 
         QoreValue rv = entry[offset];
         if (needs_scan(rv)) {
@@ -324,6 +634,7 @@ struct qore_list_private {
 
     DLLLOCAL QoreListNode* spliceIntern(size_t offset, size_t len, bool extract) {
         //printd(5, "spliceIntern(offset: %d, len: %d, length: %d)\n", offset, len, length);
+        makeWritable();
         size_t end;
         if (len > (length - offset)) {
             end = length;
@@ -363,7 +674,7 @@ struct qore_list_private {
             holder = tmp = sl->getCopy();
             tmp->priv->reserve(sl->length);
             for (size_t i = 0; i < sl->length; ++i) {
-                ValueHolder eh(sl->entry[i].refSelf(), xsink);
+                ValueHolder eh(sl->getValue(i).refSelf(), xsink);
                 if (checkVal(eh, xsink)) {
                     return nullptr;
                 }
@@ -378,6 +689,7 @@ struct qore_list_private {
         }
 
         //printd(5, "spliceIntern(offset: %d, len: %d, length: %d)\n", offset, len, length);
+        makeWritable();
         size_t end;
         if (len > (length - offset)) {
             end = length;
@@ -435,6 +747,7 @@ struct qore_list_private {
     }
 
     DLLLOCAL QoreValue& getEntryReference(size_t num) {
+        makeWritable();
         if (num >= length) {
             resize(num + 1);
         }
@@ -445,6 +758,7 @@ struct qore_list_private {
         if (i >= length) {
             return QoreValue();
         }
+        makeWritable();
         QoreValue rv = entry[i];
         entry[i] = QoreValue();
 
@@ -497,6 +811,7 @@ struct qore_list_private {
             return QoreValue();
         }
 
+        makeWritable();
         QoreValue rv = entry[offset];
         entry[offset].assignNothing();
 
@@ -512,8 +827,16 @@ struct qore_list_private {
             return;
         // make larger
         if (num >= allocated) {
+            if (shared) {
+                detach(num);
+                return;
+            }
             size_t d = num >> 2;
             allocated = num + (d < LIST_PAD ? LIST_PAD : d);
+            if (packed_type) {
+                packed = realloc(packed, sizeof(int64) * allocated);
+                return;
+            }
 #pragma GCC diagnostic ignored "-Wclass-memaccess"
             entry = (QoreValue*)realloc(entry, sizeof(QoreValue) * allocated);
 #pragma GCC diagnostic pop
@@ -521,13 +844,19 @@ struct qore_list_private {
     }
 
     DLLLOCAL void resize(size_t num) {
-        if (num < length) { // make smaller
+        if (num <= length) { // make smaller
             //entry = (QoreValue*)realloc(entry, sizeof(QoreValue*) * num);
             length = num;
             return;
         }
         // make larger
         if (num >= length) {
+            // new entries have no value and cannot be stored unboxed
+            if (packed_type) {
+                unpack();
+            } else if (shared) {
+                detach(num);
+            }
             if (num >= allocated) {
                 size_t d = num >> 2;
                 allocated = num + (d < LIST_PAD ? LIST_PAD : d);
@@ -573,6 +902,12 @@ struct qore_list_private {
 
     DLLLOCAL QoreListNode* eval(ExceptionSink* xsink);
 
+    //! returns an empty list for evaluation results, reusing a list recycled by the current thread if possible
+    DLLLOCAL static QoreListNode* getEvalList(const QoreTypeInfo* complexTypeInfo);
+
+    //! dereferences a list holding temporary evaluation results; unique lists are recycled in the current thread
+    DLLLOCAL static void derefEvalList(QoreListNode* l, ExceptionSink* xsink);
+
     DLLLOCAL void weakRef() {
         weakRefs.ROreference();
     }
@@ -52,6 +52,7 @@ extern QoreHashNode* ENV;
 #include "qore/vector_map"
 #include "qore/vector_set"
 
+#include <atomic>
 #include <cerrno>
 #include <cstdarg>
 #include <map>
@@ -105,6 +106,10 @@ typedef QoreThreadLocalStorage<QoreHashNode> qpgm_thread_local_storage_t;
 #include "qore/intern/ThreadLocalVariableData.h"
 #include "qore/intern/ThreadClosureVariableStack.h"
 
+// set when a Program is attached to a debug program for the first time; until then no debugger checks are made when
+// executing statements
+DLLLOCAL extern std::atomic<bool> qore_debug_attached;
+
 struct ThreadLocalProgramData {
 public:
     // local variable data slots
@@ -2251,6 +2256,8 @@ public:
         if (dpgm == n_dpgm)
             return;
         dpgm = const_cast<qore_debug_program_private*>(n_dpgm);
+        // switch all threads to statement execution with debugger checks
+        qore_debug_attached.store(true, std::memory_order_release);
         printd(5, "qore_program_private::attachDebug, dpgm: %p, pgm_data_map: size:%d, begin: %p, end: %p\n", dpgm,
             pgm_data_map.size(), pgm_data_map.begin(), pgm_data_map.end());
         for (auto& i : pgm_data_map) {
@@ -34,6 +34,7 @@
 #ifndef _QORE_QORE_THREAD_INTERN_H
 #define _QORE_QORE_THREAD_INTERN_H
 
+#include <atomic>
 #include <vector>
 #include <set>
 #include <map>
@@ -240,11 +241,15 @@ DLLLOCAL void update_runtime_stack_location(const QoreStackLocation* stack_loc);
 DLLLOCAL void update_runtime_stack_location(const QoreStackLocation* stack_loc, const QoreProgramLocation* runtime_loc);
 
 DLLLOCAL const QoreProgramLocation* get_runtime_location();
-DLLLOCAL int swap_runtime_statement_location(ExceptionSink* xsink, const AbstractStatement* stmt,
-        const QoreProgramLocation* loc, int64 po, const AbstractStatement*& old_stmt,
-        const QoreProgramLocation*& old_loc, int64& old_po);
+DLLLOCAL int swap_runtime_statement(ExceptionSink* xsink, const AbstractStatement* stmt,
+        const AbstractStatement*& old_stmt, const QoreProgramLocation*& old_loc);
+// sets the block as the current statement and checks the stack once for a block executed with pre-decoded
+// instructions; returns the thread data to use with set_runtime_statement() for each instruction executed
+DLLLOCAL ThreadData* swap_runtime_block(ExceptionSink* xsink, const AbstractStatement* block,
+        const AbstractStatement*& old_stmt, const QoreProgramLocation*& old_loc);
+DLLLOCAL void set_runtime_statement(ThreadData* td, const AbstractStatement* stmt);
 DLLLOCAL void swap_runtime_location(const QoreProgramLocation*loc, const AbstractStatement*& old_stmt,
-        const QoreProgramLocation*& old_loc);
+        const QoreProgramLocation*& old_loc, int64& old_po);
 DLLLOCAL void update_runtime_statement_location(const AbstractStatement* stmt, const QoreProgramLocation* loc, int64 po);
 DLLLOCAL void update_runtime_statement_location(const AbstractStatement* stmt, const QoreProgramLocation* loc);
 
@@ -259,6 +264,11 @@ DLLLOCAL const QoreTypeInfo* parse_get_implicit_arg_type_info();
 DLLLOCAL int64 parse_get_parse_options();
 DLLLOCAL int64 runtime_get_parse_options();
 
+// returns an empty list recycled by the current thread or nullptr if none is available
+DLLLOCAL QoreListNode* get_thread_eval_list();
+// saves an empty unique list for reuse by the current thread; returns false if the list was not saved
+DLLLOCAL bool put_thread_eval_list(QoreListNode* l);
+
 DLLLOCAL bool parse_check_parse_option(int64 o);
 DLLLOCAL bool runtime_check_parse_option(int64 o);
 
@@ -465,50 +475,79 @@ protected:
     qore_call_t call_type;
 };
 
-class QoreProgramLocationHelper {
+// sets the current statement while it's executing; the runtime location and parse options are resolved from the
+// statement only when needed
+class QoreProgramStatementHelper {
+public:
+    DLLLOCAL QoreProgramStatementHelper(ExceptionSink* xsink, const AbstractStatement* stat) {
+        swap_runtime_statement(xsink, stat, statement, loc);
+    }
+
+    DLLLOCAL ~QoreProgramStatementHelper() {
+        update_runtime_statement_location(statement, loc);
+    }
+
+protected:
+    const QoreProgramLocation* loc;
+    const AbstractStatement* statement;
+};
+
+// sets the current statement for each instruction of a statement block executed with pre-decoded instructions; the
+// thread data is looked up and the stack is checked once for the block instead of for each statement
+class QoreProgramBlockStatementHelper {
 public:
-    DLLLOCAL QoreProgramLocationHelper(ExceptionSink* xsink, const QoreProgramLocation* loc,
-            const AbstractStatement* stat, int64 parse_options) : has_po(true) {
-        swap_runtime_statement_location(xsink, stat, loc, parse_options, statement, this->loc,
-            this->parse_options);
+    DLLLOCAL QoreProgramBlockStatementHelper(ExceptionSink* xsink, const AbstractStatement* block)
+            : td(swap_runtime_block(xsink, block, statement, loc)) {
+    }
+
+    DLLLOCAL ~QoreProgramBlockStatementHelper() {
+        update_runtime_statement_location(statement, loc);
     }
 
-    DLLLOCAL QoreProgramLocationHelper(const QoreProgramLocation* loc) : has_po(false) {
-        swap_runtime_location(loc, statement, this->loc);
+    DLLLOCAL void set(const AbstractStatement* stmt) {
+        set_runtime_statement(td, stmt);
+    }
+
+protected:
+    const QoreProgramLocation* loc;
+    const AbstractStatement* statement;
+    ThreadData* td;
+};
+
+class QoreProgramLocationHelper {
+public:
+    DLLLOCAL QoreProgramLocationHelper(const QoreProgramLocation* loc) {
+        swap_runtime_location(loc, statement, this->loc, parse_options);
     }
 
     DLLLOCAL ~QoreProgramLocationHelper() {
-        if (has_po) {
-            update_runtime_statement_location(statement, loc, parse_options);
-        } else {
-            update_runtime_statement_location(statement, loc);
-        }
+        update_runtime_statement_location(statement, loc, parse_options);
     }
 
 protected:
     const QoreProgramLocation* loc;
     const AbstractStatement* statement;
     int64 parse_options;
-    bool has_po;
 };
 
 class QoreProgramOptionalLocationHelper {
 public:
     DLLLOCAL QoreProgramOptionalLocationHelper(const QoreProgramLocation* loc) : restore((bool)loc) {
         if (loc) {
-            swap_runtime_location(loc, statement, this->loc);
+            swap_runtime_location(loc, statement, this->loc, parse_options);
         }
     }
 
     DLLLOCAL ~QoreProgramOptionalLocationHelper() {
         if (restore) {
-            update_runtime_statement_location(statement, loc);
+            update_runtime_statement_location(statement, loc, parse_options);
         }
     }
 
 protected:
     const QoreProgramLocation* loc;
     const AbstractStatement* statement;
+    int64 parse_options;
     bool restore;
 };
 
@@ -540,6 +579,10 @@ private:
    const QoreTypeInfo* ati;
 };
 
+// number of native threads created and reused for the background operator
+DLLLOCAL extern std::atomic<int64> qore_bg_threads_created;
+DLLLOCAL extern std::atomic<int64> qore_bg_threads_reused;
+
 // acquires a TID and thread entry, returns -1 if not successful
 DLLLOCAL int get_thread_entry(bool reuse_last = false);
 // acquires TID 0 and sets up the signal thread entry, always returns 0
@@ -628,7 +671,8 @@ public:
 
 DLLLOCAL const QoreListNode* thread_get_implicit_args();
 
-DLLLOCAL LocalVarValue* thread_find_lvar(const char* id);
+// finds the local variable on the stack; "slot" is the variable's frame offset hint, updated if invalid
+DLLLOCAL LocalVarValue* thread_find_lvar(const char* id, std::atomic<int>& slot);
 
 // to get the current runtime object
 DLLLOCAL QoreObject* runtime_get_stack_object();
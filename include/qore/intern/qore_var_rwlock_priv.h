@@ -34,6 +34,8 @@
 #ifndef _QORE_VAR_RWLOCK_PRIV_H
 #define _QORE_VAR_RWLOCK_PRIV_H
 
+#include <atomic>
+
 class qore_var_rwlock_priv {
 protected:
    DLLLOCAL virtual void notifyIntern() {
@@ -53,6 +55,8 @@ public:
    QoreCondition write_cond,
       read_cond;
    bool has_notify;
+   //! write sequence counter for optimistic readers; odd while the write lock is held
+   std::atomic<unsigned> write_seq = {0};
 
    //! creates and initializes the lock
    DLLLOCAL qore_var_rwlock_priv() : write_tid(-1), readers(0), read_waiting(0), write_waiting(0), has_notify(false) {
@@ -62,6 +66,12 @@ public:
    DLLLOCAL virtual ~qore_var_rwlock_priv() {
    }
 
+   //! marks the start of a write for optimistic readers
+   DLLLOCAL void beginWrite() {
+      write_seq.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+   }
+
    //! grabs the write lock
    DLLLOCAL void wrlock() {
       int tid = q_gettid();
@@ -75,6 +85,7 @@ public:
       }
 
       write_tid = tid;
+      beginWrite();
    }
 
    //! tries to grab the write lock; does not block if unsuccessful; returns 0 if successful
@@ -86,6 +97,7 @@ public:
          return -1;
 
       write_tid = tid;
+      beginWrite();
       return 0;
    }
 
@@ -95,6 +107,7 @@ public:
       AutoLocker al(l);
       if (write_tid == tid) {
          write_tid = -1;
+         write_seq.fetch_add(1, std::memory_order_release);
          if (has_notify)
             notifyIntern();
 
@@ -131,6 +144,11 @@ public:
       return 0;
    }
 
+   //! returns the current write sequence; an odd value means that a writer holds the lock
+   DLLLOCAL unsigned getWriteSeq() const {
+      return write_seq.load(std::memory_order_acquire);
+   }
+
    DLLLOCAL void unlock_signal() {
       if (write_waiting)
          write_cond.signal();
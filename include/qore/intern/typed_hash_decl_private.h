@@ -35,9 +35,11 @@
 
 #include "qore/intern/QoreClassIntern.h"
 
+#include <atomic>
 #include <string>
 
 class typed_hash_decl_private;
+class QoreHashShape;
 
 class HashDeclMemberInfo : public QoreMemberInfoBase {
 public:
@@ -74,10 +76,7 @@ public:
 
     DLLLOCAL typed_hash_decl_private(const typed_hash_decl_private& old, TypedHashDecl* thd);
 
-    DLLLOCAL ~typed_hash_decl_private() {
-        delete typeInfo;
-        delete orNothingTypeInfo;
-    }
+    DLLLOCAL ~typed_hash_decl_private();
 
     DLLLOCAL TypedHashDecl* newTypedHashDecl(const char* n) {
         assert(name.empty());
@@ -192,6 +191,9 @@ public:
 
     DLLLOCAL int initHash(QoreHashNode* h, const QoreHashNode* init, ExceptionSink* xsink) const;
 
+    //! returns the key layout of hashes of this type; created on first use
+    DLLLOCAL const QoreHashShape* getShape() const;
+
     DLLLOCAL int runtimeAssignKey(const char* key, ValueHolder& val, ExceptionSink* xsink) const {
         const HashDeclMemberInfo* mem = members.find(key);
         if (!mem) {
@@ -302,6 +304,8 @@ protected:
 
     // member information
     HashDeclMemberMap members;
+    // the key layout for new hashes; created on first use after the members are final
+    mutable std::atomic<const QoreHashShape*> shape = {nullptr};
 
     bool pub = false;
     bool sys = false;
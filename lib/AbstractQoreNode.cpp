@@ -33,6 +33,7 @@
 #include "qore/intern/QoreHashNodeIntern.h"
 #include "qore/intern/QoreClosureNode.h"
 #include "qore/intern/QoreParseHashNode.h"
+#include "qore/intern/QoreObjectIntern.h"
 
 #include <cassert>
 #include <cstdio>
@@ -545,7 +546,9 @@ bool needs_scan(const AbstractQoreNode* n) {
     switch (n->getType()) {
         case NT_LIST: return qore_list_private::getScanCount(*static_cast<const QoreListNode*>(n)) ? true : false;
         case NT_HASH: return qore_hash_private::getScanCount(*static_cast<const QoreHashNode*>(n)) ? true : false;
-        case NT_OBJECT: return true;
+        case NT_OBJECT:
+            // objects of cycle-free classes can never be part of a recursive reference
+            return !qore_object_private::get(*static_cast<const QoreObject*>(n))->cycle_free;
         case NT_RUNTIME_CLOSURE: return static_cast<const QoreClosureBase*>(n)->needsScan();
         case NT_REFERENCE: return lvalue_ref::get(static_cast<const ReferenceNode*>(n))->needsScan();
     }
@@ -557,6 +560,11 @@ bool needs_scan(const QoreValue& v) {
     return needs_scan(v.getInternalNode());
 }
 
+bool is_cycle_free_object(const AbstractQoreNode* n) {
+    return n && n->getType() == NT_OBJECT
+        && qore_object_private::get(*static_cast<const QoreObject*>(n))->cycle_free;
+}
+
 void inc_container_obj(const AbstractQoreNode* n, int dt) {
     assert(n);
     switch (n->getType()) {
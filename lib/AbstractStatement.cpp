@@ -86,7 +86,7 @@ void AbstractStatement::finalizeBlock(int sline, int eline) {
 int AbstractStatement::exec(QoreValue& return_value, ExceptionSink *xsink) {
     //QORE_TRACE("AbstractStatement::exec()");
     printd(1, "AbstractStatement::exec() this: %p file: %s:%d\n", this, loc->getFile(), loc->start_line);
-    QoreProgramLocationHelper stack_loc(xsink, loc, this, pwo.parse_options);
+    QoreProgramStatementHelper stack_loc(xsink, this);
     //pthread_testcancel();
     if (*xsink) {
         return 0;
@@ -430,7 +430,7 @@ void ExceptionSink::defaultExceptionHandler(QoreException* e) {
         printe("unhandled QORE %s exception thrown in TID %d at %s",
             e->type == CT_USER ? "User" : "System", q_gettid(), nstr.getBuffer());
 
-        QoreListNode* cs = e->callStack;
+        QoreListNode* cs = e->getCallStack();
         bool found = false;
         if (cs->size()) {
             // find first non-rethrow element
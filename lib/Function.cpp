@@ -176,7 +176,7 @@ static void add_args(QoreStringNode &desc, const QoreListNode* args) {
 CodeEvaluationHelper::CodeEvaluationHelper(ExceptionSink* n_xsink, const QoreFunction* func,
         const AbstractQoreFunctionVariant*& variant, const char* n_name, const QoreListNode* args, QoreObject* self,
         const qore_class_private* n_qc, qore_call_t n_ct, bool is_copy, const qore_class_private* cctx,
-        QoreProgram* pgm_ctx)
+        QoreProgram* pgm_ctx, bool check_args)
     : ct(n_ct), name(n_name), xsink(n_xsink), qc(n_qc),
         loc(get_runtime_location()),
         tmp(n_xsink), returnTypeInfo((const QoreTypeInfo*)-1) {
@@ -193,7 +193,7 @@ CodeEvaluationHelper::CodeEvaluationHelper(ExceptionSink* n_xsink, const QoreFun
         return;
     }
 
-    init(func, variant, is_copy, cctx, self, pgm_ctx);
+    init(func, variant, is_copy, cctx, self, pgm_ctx, check_args);
 }
 
 CodeEvaluationHelper::CodeEvaluationHelper(ExceptionSink* n_xsink, const QoreFunction* func,
@@ -241,7 +241,7 @@ void CodeEvaluationHelper::setCallName(const QoreFunction* func) {
 }
 
 void CodeEvaluationHelper::init(const QoreFunction* func, const AbstractQoreFunctionVariant*& variant, bool is_copy,
-        const qore_class_private* cctx, QoreObject* self, QoreProgram* pgm_ctx) {
+        const qore_class_private* cctx, QoreObject* self, QoreProgram* pgm_ctx, bool check_args) {
     //printd(5, "CodeEvaluationHelper::init() this: %p '%s()' file: %s line: %d variant: %p cctx: %p (%s)\n", this,
     //    func->getName(), loc->getFile(), loc->start_line, variant, cctx, cctx ? cctx->name.c_str() : "n/a");
 
@@ -278,7 +278,8 @@ void CodeEvaluationHelper::init(const QoreFunction* func, const AbstractQoreFunc
         }
     }
 
-    if (processDefaultArgs(func, variant, true, is_copy, self)) {
+    // arguments verified at parse time have no default arguments and need no type checks or conversions
+    if (check_args && processDefaultArgs(func, variant, true, is_copy, self)) {
         return;
     }
 
@@ -965,9 +966,133 @@ QoreListNode* QoreFunction::runtimeGetCallVariants() const {
     return rv->empty() ? nullptr : rv.release();
 }
 
+std::atomic<unsigned> qore_variant_epoch = {0};
+
+// maximum number of arguments in a cacheable call: 4 bits for the count and 4 bits per argument after the flags
+#define QORE_VARIANT_CACHE_MAX_ARGS 14
+// set in all valid signatures
+#define QORE_VARIANT_SIG_VALID (1ull << 63)
+#define QORE_VARIANT_SIG_ONLY_USER (1ull << 4)
+
+uint64_t RuntimeVariantCache::getSignature(const QoreListNode* args, bool only_user) {
+    unsigned nargs = args ? args->size() : 0;
+    if (nargs > QORE_VARIANT_CACHE_MAX_ARGS) {
+        return 0;
+    }
+
+    uint64_t sig = QORE_VARIANT_SIG_VALID | nargs;
+    if (only_user) {
+        sig |= QORE_VARIANT_SIG_ONLY_USER;
+    }
+
+    for (unsigned i = 0; i < nargs; ++i) {
+        qore_type_t t = args->retrieveEntry(i).getType();
+        // only types where variant matching does not depend on the value can be cached
+        switch (t) {
+            case NT_NOTHING:
+            case NT_INT:
+            case NT_FLOAT:
+            case NT_STRING:
+            case NT_DATE:
+            case NT_BOOLEAN:
+            case NT_NULL:
+            case NT_BINARY:
+            case NT_NUMBER:
+                assert(t >= 0 && t < 16);
+                sig |= (uint64_t)t << (5 + (i * 4));
+                break;
+
+            default:
+                return 0;
+        }
+    }
+
+    return sig;
+}
+
+const AbstractQoreFunctionVariant* RuntimeVariantCache::find(uint64_t sig, int64 ppo,
+        const qore_class_private* class_ctx) const {
+    unsigned s = seq.load(std::memory_order_acquire);
+    if ((s & 1)
+        || class_epoch.load(std::memory_order_relaxed) != qore_class_epoch.load(std::memory_order_acquire)
+        || variant_epoch.load(std::memory_order_relaxed) != qore_variant_epoch.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    const AbstractQoreFunctionVariant* rv = nullptr;
+    for (int i = 0; i < QORE_VARIANT_CACHE_SIZE; ++i) {
+        const entry_t& e = entries[i];
+        if (e.sig.load(std::memory_order_relaxed) == sig
+            && e.ppo.load(std::memory_order_relaxed) == ppo
+            && e.class_ctx.load(std::memory_order_relaxed) == class_ctx) {
+            rv = e.variant.load(std::memory_order_relaxed);
+            break;
+        }
+    }
+
+    // make sure that the entries were not updated while they were being read
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return seq.load(std::memory_order_relaxed) == s ? rv : nullptr;
+}
+
+void RuntimeVariantCache::add(uint64_t sig, int64 ppo, const qore_class_private* class_ctx,
+        const AbstractQoreFunctionVariant* variant) {
+    assert(sig);
+    unsigned s = seq.load(std::memory_order_relaxed);
+    // skip the update if another thread is updating the cache
+    if ((s & 1) || !seq.compare_exchange_strong(s, s + 1, std::memory_order_acquire)) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    unsigned current_class_epoch = qore_class_epoch.load(std::memory_order_acquire);
+    unsigned current_variant_epoch = qore_variant_epoch.load(std::memory_order_acquire);
+    if (class_epoch.load(std::memory_order_relaxed) != current_class_epoch
+        || variant_epoch.load(std::memory_order_relaxed) != current_variant_epoch) {
+        for (int i = 0; i < QORE_VARIANT_CACHE_SIZE; ++i) {
+            entries[i].sig.store(0, std::memory_order_relaxed);
+        }
+        next = 0;
+        class_epoch.store(current_class_epoch, std::memory_order_relaxed);
+        variant_epoch.store(current_variant_epoch, std::memory_order_relaxed);
+    }
+
+    entry_t& e = entries[next];
+    e.sig.store(sig, std::memory_order_relaxed);
+    e.ppo.store(ppo, std::memory_order_relaxed);
+    e.class_ctx.store(class_ctx, std::memory_order_relaxed);
+    e.variant.store(variant, std::memory_order_relaxed);
+    next = (next + 1) % QORE_VARIANT_CACHE_SIZE;
+
+    seq.store(s + 2, std::memory_order_release);
+}
+
 // finds a variant at runtime
 const AbstractQoreFunctionVariant* QoreFunction::runtimeFindVariant(ExceptionSink* xsink, const QoreListNode* args,
         bool only_user, const qore_class_private* class_ctx) const {
+    int64 ppo = runtime_get_parse_options();
+
+    // variant matching for calls with the same argument types in the same context always gives the same result
+    uint64_t sig = RuntimeVariantCache::getSignature(args, only_user);
+    const AbstractQoreFunctionVariant* variant = sig ? variant_cache.find(sig, ppo, class_ctx) : nullptr;
+    if (variant) {
+        q_inc_thread_stat(QSTAT_VARIANT_CACHE_HITS);
+    } else {
+        variant = runtimeMatchVariant(xsink, args, only_user, class_ctx, ppo);
+        if (!variant) {
+            return nullptr;
+        }
+        if (sig) {
+            q_inc_thread_stat(QSTAT_VARIANT_CACHE_MISSES);
+            variant_cache.add(sig, ppo, class_ctx, variant);
+        }
+    }
+
+    return runtimeCheckVariantAccess(xsink, variant, only_user, ppo) ? nullptr : variant;
+}
+
+const AbstractQoreFunctionVariant* QoreFunction::runtimeMatchVariant(ExceptionSink* xsink, const QoreListNode* args,
+        bool only_user, const qore_class_private* class_ctx, int64 ppo) const {
     // the lowest score length with the highest score wins
     int score_len = -1;
     int score = -1;
@@ -987,8 +1112,6 @@ const AbstractQoreFunctionVariant* QoreFunction::runtimeFindVariant(ExceptionSin
     const qore_class_private* last_class = nullptr;
     bool internal_access = false;
 
-    int64 ppo = runtime_get_parse_options();
-
     int cnt = 0;
 
     // iterate through inheritance list
@@ -1179,39 +1302,43 @@ const AbstractQoreFunctionVariant* QoreFunction::runtimeFindVariant(ExceptionSin
             }
         }
         xsink->raiseException("RUNTIME-OVERLOAD-ERROR", desc);
-    } else if (variant) {
-        QoreProgram* pgm = getProgram();
+    }
 
-        // pgm could be zero if called from a foreign thread with no current Program
-        if (pgm) {
-            // get runtime parse options
-            int64 po = variant->getParseOptions(ppo);
-
-            // check parse options
-            int64 vflags = variant->getFunctionality();
-            // check restrictive flags
-            //printd(5, "QoreFunction::runtimeFindVariant() this: %p %s() returning %p %s(%s) vflags: " QLLD " po: " QLLD
-            //    " neg: " QLLD "\n", this, getName(), variant, getName(),
-            //    variant ? variant->getSignature()->getSignatureText() : "n/a", (vflags & po & ~PO_POSITIVE_OPTIONS));
-            if ((vflags & po & ~PO_POSITIVE_OPTIONS) || ((vflags & PO_POSITIVE_OPTIONS) && (((vflags & PO_POSITIVE_OPTIONS) & po) != (vflags & PO_POSITIVE_OPTIONS)))) {
-                //printd(5, "QoreFunction::runtimeFindVariant() this: %p %s(%s) getProgram(): %p getProgram()->getParseOptions64(): %x variant->getFunctionality(): %x\n", this, getName(), variant->getSignature()->getSignatureText(), getProgram(), getProgram()->getParseOptions64(), variant->getFunctionality());
-                if (!only_user) {
-                    std::string class_path = classPath();
-                    xsink->raiseException("INVALID-FUNCTION-ACCESS", "parse options do not allow access to builtin " \
-                        "%s '%s%s%s(%s)'", !class_path.empty() ? "method" : "function",
-                        !class_path.empty() ? class_path.c_str() : "", !class_path.empty() ? "::" : "", getName(),
-                        variant->getSignature()->getSignatureText());
-                }
-                return 0;
-            }
+    //printd(5, "QoreFunction::runtimeMatchVariant() this: %p %s() returning %p %s(%s) class: %s\n", this, getName(), variant, getName(), variant ? variant->getSignature()->getSignatureText() : "n/a", variant && aqf && aqf->className() ? aqf->className() : "n/a");
+
+    return variant;
+}
+
+int QoreFunction::runtimeCheckVariantAccess(ExceptionSink* xsink, const AbstractQoreFunctionVariant* variant,
+        bool only_user, int64 ppo) const {
+    QoreProgram* pgm = getProgram();
+
+    // pgm could be zero if called from a foreign thread with no current Program
+    if (pgm) {
+        // get runtime parse options
+        int64 po = variant->getParseOptions(ppo);
 
-            assert(!(po & (PO_REQUIRE_TYPES|PO_STRICT_ARGS)) || !(variant->getFlags() & QCF_RUNTIME_NOOP));
+        // check parse options
+        int64 vflags = variant->getFunctionality();
+        // check restrictive flags
+        //printd(5, "QoreFunction::runtimeCheckVariantAccess() this: %p %s() %p %s(%s) vflags: " QLLD " po: " QLLD
+        //    " neg: " QLLD "\n", this, getName(), variant, getName(), variant->getSignature()->getSignatureText(),
+        //    (vflags & po & ~PO_POSITIVE_OPTIONS));
+        if ((vflags & po & ~PO_POSITIVE_OPTIONS) || ((vflags & PO_POSITIVE_OPTIONS) && (((vflags & PO_POSITIVE_OPTIONS) & po) != (vflags & PO_POSITIVE_OPTIONS)))) {
+            if (!only_user) {
+                std::string class_path = classPath();
+                xsink->raiseException("INVALID-FUNCTION-ACCESS", "parse options do not allow access to builtin " \
+                    "%s '%s%s%s(%s)'", !class_path.empty() ? "method" : "function",
+                    !class_path.empty() ? class_path.c_str() : "", !class_path.empty() ? "::" : "", getName(),
+                    variant->getSignature()->getSignatureText());
+            }
+            return -1;
         }
-    }
 
-    //printd(5, "QoreFunction::runtimeFindVariant() this: %p %s() returning %p %s(%s) class: %s\n", this, getName(), variant, getName(), variant ? variant->getSignature()->getSignatureText() : "n/a", variant && aqf && aqf->className() ? aqf->className() : "n/a");
+        assert(!(po & (PO_REQUIRE_TYPES|PO_STRICT_ARGS)) || !(variant->getFlags() & QCF_RUNTIME_NOOP));
+    }
 
-    return variant;
+    return 0;
 }
 
 // finds a variant at runtime
@@ -1857,6 +1984,19 @@ QoreValue QoreFunction::evalFunctionTmpArgs(const AbstractQoreFunctionVariant* v
     return variant->evalFunction(fname, ceh, xsink);
 }
 
+QoreValue QoreFunction::evalFunctionCheckedArgs(const AbstractQoreFunctionVariant* variant, const QoreListNode* args,
+        QoreProgram* pgm, ExceptionSink* xsink) const {
+    assert(variant && !variant->isUser());
+    const char* fname = getName();
+    CodeEvaluationHelper ceh(xsink, this, variant, fname, args, nullptr, nullptr, CT_UNUSED, false, nullptr, nullptr,
+        false);
+    if (*xsink) return QoreValue();
+    // issue #3024: make the caller's call context available
+    ProgramCallContextHelper pcch(pgm);
+
+    return variant->evalFunction(fname, ceh, xsink);
+}
+
 // finds a variant and checks variant capabilities against current
 // program parse options
 QoreValue QoreFunction::evalDynamic(const QoreListNode* args, ExceptionSink* xsink) const {
@@ -2350,6 +2490,9 @@ void QoreFunction::parseCommit() {
 
     parse_rt_done = true;
     parse_init_done = true;
+
+    // invalidate runtime variant caches
+    qore_variant_epoch.fetch_add(1, std::memory_order_release);
 }
 
 void QoreFunction::parseRollback() {
@@ -70,7 +70,73 @@ QoreValue AbstractMethodCallNode::exec(QoreObject* o, const char* c_str, const q
     }
     //printd(5, "AbstractMethodCallNode::exec() calling QoreObject::evalMethod() for %s::%s()\n", o->getClassName(),
     //    c_str);
-    return qore_class_private::get(*o->getClass())->evalMethod(o, c_str, args, ctx, xsink);
+    const QoreClass* cls = o->getClass();
+    // copy methods are handled specially in evalMethod()
+    if (!c_str || !strcmp(c_str, "copy")) {
+        return qore_class_private::get(*cls)->evalMethod(o, c_str, args, ctx, xsink);
+    }
+
+    const QoreMethod* m = method_cache.find(cls, ctx);
+    if (!m) {
+        const qore_class_private* cpriv = qore_class_private::get(*cls);
+        m = cpriv->getMethodForEval(c_str, o->getProgram(), ctx, xsink);
+        if (*xsink) {
+            return QoreValue();
+        }
+        // pseudo-methods, method gates, and errors are handled in evalMethod()
+        if (!m) {
+            return cpriv->evalMethod(o, c_str, args, ctx, xsink);
+        }
+        method_cache.add(cls, ctx, m);
+    }
+    return qore_method_private::eval(*m, xsink, o, args, ctx);
+}
+
+const QoreMethod* MethodCallSiteCache::find(const QoreClass* cls, const qore_class_private* class_ctx) const {
+    unsigned s = seq.load(std::memory_order_acquire);
+    if ((s & 1) || epoch.load(std::memory_order_relaxed) != qore_class_epoch.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    const QoreMethod* rv = nullptr;
+    for (int i = 0; i < QORE_METHOD_CACHE_SIZE; ++i) {
+        const entry_t& e = entries[i];
+        if (e.cls.load(std::memory_order_relaxed) == cls
+            && e.class_ctx.load(std::memory_order_relaxed) == class_ctx) {
+            rv = e.method.load(std::memory_order_relaxed);
+            break;
+        }
+    }
+
+    // make sure that the entries were not updated while they were being read
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return seq.load(std::memory_order_relaxed) == s ? rv : nullptr;
+}
+
+void MethodCallSiteCache::add(const QoreClass* cls, const qore_class_private* class_ctx, const QoreMethod* m) {
+    unsigned s = seq.load(std::memory_order_relaxed);
+    // skip the update if another thread is updating the cache
+    if ((s & 1) || !seq.compare_exchange_strong(s, s + 1, std::memory_order_acquire)) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    unsigned current_epoch = qore_class_epoch.load(std::memory_order_acquire);
+    if (epoch.load(std::memory_order_relaxed) != current_epoch) {
+        for (int i = 0; i < QORE_METHOD_CACHE_SIZE; ++i) {
+            entries[i].cls.store(nullptr, std::memory_order_relaxed);
+        }
+        next = 0;
+        epoch.store(current_epoch, std::memory_order_relaxed);
+    }
+
+    entry_t& e = entries[next];
+    e.cls.store(cls, std::memory_order_relaxed);
+    e.class_ctx.store(class_ctx, std::memory_order_relaxed);
+    e.method.store(m, std::memory_order_relaxed);
+    next = (next + 1) % QORE_METHOD_CACHE_SIZE;
+
+    seq.store(s + 2, std::memory_order_release);
 }
 
 const QoreTypeInfo* AbstractMethodCallNode::getTypeInfo() const {
@@ -142,6 +208,59 @@ static void check_flags(const QoreProgramLocation* loc, QoreFunction* func, int6
     }
 }
 
+// returns true if the argument expression is guaranteed to provide a value of its parse-time type at runtime
+static bool parse_arg_has_value(QoreValue arg) {
+    if (arg.isNothing()) {
+        return false;
+    }
+    if (!arg.needsEval()) {
+        return true;
+    }
+    // local variables declared with %strict-types are always assigned the default value of their declared type; the
+    // value is also restored to the type's default value when removed if %strict-types is in effect; types without a
+    // default value (ex: objects and code) leave the variable with no value until assigned
+    if (arg.getType() == NT_VARREF && parse_check_parse_option(PO_STRICT_TYPES)) {
+        const VarRefNode* v = arg.get<const VarRefNode>();
+        qore_var_t t = v->getType();
+        if (t != VT_LOCAL && t != VT_CLOSURE && t != VT_LOCAL_TS) {
+            return false;
+        }
+        const QoreTypeInfo* typeInfo = v->ref.id->getTypeInfo();
+        return v->ref.id->isStrictInit() && !QoreTypeInfo::isReference(typeInfo)
+            && QoreTypeInfo::hasDefaultValue(typeInfo);
+    }
+    return false;
+}
+
+// returns true if the argument types match the parameters of the given builtin variant so that the arguments need no
+// default argument processing, type checks, or conversions at runtime; a parse-time type does not guarantee a value
+// at runtime, so each argument must also be an expression that cannot return NOTHING
+static bool parse_check_builtin_args(const AbstractQoreFunctionVariant* variant, const type_vec_t& argTypeInfo,
+        const QoreListNode* args) {
+    AbstractFunctionSignature* sig = variant->getSignature();
+    if (sig->numParams() != argTypeInfo.size() || (args ? args->size() : 0) != argTypeInfo.size()) {
+        return false;
+    }
+    const arg_vec_t& defaultArgList = sig->getDefaultArgList();
+    for (unsigned i = 0; i < argTypeInfo.size(); ++i) {
+        if (i < defaultArgList.size() && defaultArgList[i]) {
+            return false;
+        }
+        const QoreTypeInfo* paramTypeInfo = sig->getParamTypeInfo(i);
+        if (!QoreTypeInfo::hasType(paramTypeInfo) || QoreTypeInfo::isReference(paramTypeInfo)
+            || !QoreTypeInfo::hasType(argTypeInfo[i]) || !parse_arg_has_value(args->retrieveEntry(i))) {
+            return false;
+        }
+        bool may_not_match = false;
+        bool may_need_filter = false;
+        if (QoreTypeInfo::parseAccepts(paramTypeInfo, argTypeInfo[i], may_not_match, may_need_filter)
+            == QTI_NOT_EQUAL || may_not_match || may_need_filter) {
+            return false;
+        }
+    }
+    return true;
+}
+
 int FunctionCallBase::parseArgsVariant(const QoreProgramLocation* loc, QoreParseContext& parse_context,
         QoreFunction* func, qore_ns_private* ns) {
     int err = 0;
@@ -234,6 +353,9 @@ int FunctionCallBase::parseArgsVariant(const QoreProgramLocation* loc, QoreParse
                     invalid_access(loc, func);
                 int64 flags = variant->getFlags();
                 check_flags(loc, func, flags, parse_context.pflag);
+                // calls to builtin functions with exactly-typed arguments skip runtime argument processing
+                args_checked = !qc && !variant->isUser() && parse_check_builtin_args(variant, argTypeInfo,
+                    args);
             }
         } else {
             //printd(5, "FunctionCallBase::parseArgsVariant() this: %p func: %p f: %lld (%lld) c: %lld (%lld)\n",
@@ -435,8 +557,11 @@ QoreValue FunctionCallNode::evalImpl(bool& needs_deref, ExceptionSink* xsink) co
     QoreFunction* func = fe->getFunction();
     printd(5, "FunctionCallNode::evalImpl() this: %p '%s' tmp_args: %d args: %p '%s' (%zd)\n", this,
         func->getName(), tmp_args, args, args ? get_full_type_name(args) : "n/a", args ? args->size() : 0);
-    return tmp_args
-        ? func->evalFunctionTmpArgs(variant, args, pgm, xsink)
+    if (tmp_args) {
+        return func->evalFunctionTmpArgs(variant, args, pgm, xsink);
+    }
+    return args_checked
+        ? func->evalFunctionCheckedArgs(variant, args, pgm, xsink)
         : func->evalFunction(variant, args, pgm, xsink);
 }
 
@@ -576,10 +701,39 @@ int FunctionCallNode::parseInitCall(QoreValue& val, QoreParseContext& parse_cont
     return parseInitFinalizedCall(val, parse_context);
 }
 
+// returns true if all arguments are values that do not need evaluation
+static bool args_are_values(const QoreListNode* args) {
+    for (size_t i = 0, e = args->size(); i < e; ++i) {
+        if (!args->retrieveEntry(i).isValue()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 int FunctionCallNode::parseInitFinalizedCall(QoreValue& val, QoreParseContext& parse_context) {
     assert(!parse_context.typeInfo);
     assert(fe);
-    return parseArgs(parse_context, fe->getFunction(), fe->getNamespace());
+    int err = parseArgs(parse_context, fe->getFunction(), fe->getNamespace());
+
+    // see if the call is to a pure builtin variant with constant arguments, then eval immediately and substitute this
+    // node with the result
+    if (!err && variant && !variant->isUser() && (variant->getFlags() & QCF_PURE) == QCF_PURE && args
+        && !args->empty() && args_are_values(args)) {
+        ExceptionSink xsink;
+        ValueEvalOptimizedRefHolder v(this, &xsink);
+        if (!xsink) {
+            printd(5, "FunctionCallNode::parseInitFinalizedCall() this: %p evaluated %s() at parse time\n", this,
+                fe->getFunction()->getName());
+            val = v.takeReferencedValue();
+            deref();
+        } else {
+            // leave the call to be executed at runtime
+            xsink.clear();
+        }
+    }
+
+    return err;
 }
 
 AbstractQoreNode* FunctionCallNode::makeReferenceNodeAndDerefImpl() {
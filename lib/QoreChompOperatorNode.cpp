@@ -86,7 +86,7 @@ QoreValue QoreChompOperatorNode::evalImpl(bool& needs_deref, ExceptionSink* xsin
     HashIterator hi(vh);
     while (hi.next()) {
         if (hi.get().getType() == NT_STRING) {
-            QoreValue& v = (*qhi_priv::get(hi)->i)->val;
+            QoreValue& v = qhi_priv::get(hi)->m->val;
             QoreStringNode* vs = v.get<QoreStringNode>();
             if (!vs->is_unique()) {
                 QoreStringNode* old = vs;
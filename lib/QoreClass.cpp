@@ -36,6 +36,7 @@
 #include "qore/intern/ql_crypto.h"
 #include "qore/intern/QoreObjectIntern.h"
 #include "qore/intern/QoreParseClass.h"
+#include "qore/intern/typed_hash_decl_private.h"
 
 #include <cassert>
 #include <cstdlib>
@@ -44,6 +45,9 @@
 // global class ID sequence
 DLLLOCAL Sequence classIDSeq(1);
 
+// global class epoch
+DLLLOCAL std::atomic<unsigned> qore_class_epoch(0);
+
 AbstractQoreClassUserData::~AbstractQoreClassUserData() {
 }
 
@@ -786,6 +790,9 @@ qore_class_private::qore_class_private(const qore_class_private& old, qore_ns_pr
 qore_class_private::~qore_class_private() {
     printd(5, "qore_class_private::~qore_class_private() this: %p %s\n", this, name.c_str());
 
+    // invalidate any runtime method caches that could refer to this class
+    qore_class_epoch.fetch_add(1, std::memory_order_release);
+
     if (spgm) {
         if (deref_source_program) {
             spgm->deref(nullptr);
@@ -1386,6 +1393,7 @@ void qore_class_private::parseCommit() {
 
     if (!sys) {
         committed = true;
+        qore_class_epoch.fetch_add(1, std::memory_order_release);
 
         if (parse_init_called) {
             parse_init_called = false;
@@ -1521,6 +1529,131 @@ void qore_class_private::addLocalMembersForInit() {
     }
 }
 
+// returns true if values of the given type can never hold a reference to an object that could be part of a
+// recursive reference
+static bool type_is_cycle_free(const QoreTypeInfo* ti, qcv_set_t& vset) {
+    if (!QoreTypeInfo::needsScan(ti)) {
+        return true;
+    }
+    if (!QoreTypeInfo::hasType(ti)) {
+        return false;
+    }
+
+    for (auto& i : ti->return_vec) {
+        const QoreTypeSpec& spec = i.spec;
+        switch (spec.getTypeSpec()) {
+            case QTS_TYPE:
+                switch (spec.getType()) {
+                    case NT_NOTHING:
+                    case NT_NULL:
+                    case NT_INT:
+                    case NT_FLOAT:
+                    case NT_NUMBER:
+                    case NT_BOOLEAN:
+                    case NT_STRING:
+                    case NT_DATE:
+                    case NT_BINARY:
+                        break;
+
+                    default:
+                        return false;
+                }
+                break;
+
+            case QTS_EMPTYLIST:
+            case QTS_EMPTYHASH:
+                break;
+
+            case QTS_COMPLEXLIST:
+            case QTS_COMPLEXSOFTLIST:
+            case QTS_COMPLEXHASH:
+                if (!type_is_cycle_free(spec.getElementType(), vset)) {
+                    return false;
+                }
+                break;
+
+            case QTS_HASHDECL: {
+                const typed_hash_decl_private* hd = typed_hash_decl_private::get(*spec.getHashDecl());
+                if (vset.find(hd) != vset.end()) {
+                    break;
+                }
+                vset.insert(hd);
+                for (auto& mi : hd->getMembers().member_list) {
+                    if (!type_is_cycle_free(mi.second->getTypeInfo(), vset)) {
+                        return false;
+                    }
+                }
+                break;
+            }
+
+            case QTS_CLASS: {
+                // objects of subclasses are also accepted, therefore the class must be final
+                const qore_class_private* qc = qore_class_private::get(*spec.getClass());
+                if (!qc->final || !qc->checkCycleFree(vset)) {
+                    return false;
+                }
+                break;
+            }
+
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool qore_class_private::isCycleFree() const {
+    int rc = cycle_free.load(std::memory_order_acquire);
+    if (rc >= 0) {
+        return (bool)rc;
+    }
+    // the status can only be determined once the class has been committed
+    if (!committed) {
+        return false;
+    }
+
+    qcv_set_t vset;
+    int cf = checkCycleFree(vset) ? 1 : 0;
+    // if another thread has already set the status, use the existing value
+    if (!cycle_free.compare_exchange_strong(rc, cf, std::memory_order_acq_rel)) {
+        cf = rc;
+    }
+    return (bool)cf;
+}
+
+bool qore_class_private::checkCycleFree(qcv_set_t& vset) const {
+    int rc = cycle_free.load(std::memory_order_acquire);
+    if (rc >= 0) {
+        return (bool)rc;
+    }
+    // classes referring to themselves (directly or indirectly) could form a recursive reference
+    if (sys || !committed || !has_public_memdecl || vset.find(this) != vset.end()) {
+        return false;
+    }
+    vset.insert(this);
+
+    // builtin classes in the hierarchy may have private data that could hold references
+    if (scl) {
+        for (auto& i : scl->sml) {
+            if (i.first->priv->sys) {
+                return false;
+            }
+        }
+    }
+
+    // check all members in the hierarchy
+    for (auto& i : member_init_list) {
+        if (!type_is_cycle_free(i.info->getTypeInfo(), vset)) {
+            return false;
+        }
+    }
+
+    // the class may be referenced again by other members without forming a recursive reference
+    vset.erase(this);
+    return true;
+}
+
 void qore_class_private::parseCommitRuntimeInit(ExceptionSink* xsink) {
     assert(initialized);
     // finalize constant initialization
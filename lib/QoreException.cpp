@@ -50,16 +50,42 @@ void QoreCallStack::add(qore_call_t type, const char* label, int start, int end,
     insert(begin(), QoreCallStackElement(type, label, start, end, source, offset, code, lang));
 }
 
+QoreExceptionStackFrame::QoreExceptionStackFrame(const QoreStackLocation& stack_loc)
+        : QoreExceptionLocation(stack_loc.getLocation()), code(stack_loc.getCallName()),
+        type(stack_loc.getCallType()) {
+    has_source = stack_loc.getLocation().getSource() != nullptr;
+    // the program and statement may not be valid when the call stack is read, so resolve the IDs here
+    QoreProgram* pgm = stack_loc.getProgram();
+    if (pgm) {
+        has_pgm = true;
+        programid = pgm->getProgramId();
+        const AbstractStatement* statement = stack_loc.getStatement();
+        if (statement) {
+            statementid = pgm->getStatementId(statement);
+        }
+    }
+}
+
 QoreExceptionBase::QoreExceptionBase(QoreValue n_err, QoreValue n_desc, QoreValue n_arg, qore_call_t n_type)
         : type(n_type), err(n_err), desc(n_desc), arg(n_arg) {
-    // populate call stack
+    // capture the call stack; CallStackInfo hashes are only created if the call stack is read
     const QoreStackLocation* w = get_runtime_stack_location();
     while (w) {
-        callStack->push(QoreThreadList::getCallStackHash(*w), nullptr);
+        frames.emplace_back(*w);
         w = w->getNext();
     }
 }
 
+QoreListNode* QoreException::getCallStack() const {
+    if (!frames.empty()) {
+        for (auto& i : frames) {
+            callStack->push(QoreException::getStackHash(i), nullptr);
+        }
+        frames.clear();
+    }
+    return callStack;
+}
+
 void QoreException::del(ExceptionSink* xsink) {
     if (callStack) {
         //printd(5, "QoreException::del() this: %p callStack: %p (r: %d)\n", this, callStack, callStack->reference_count());
@@ -125,9 +151,15 @@ QoreException* QoreException::rethrow() {
     // insert current position as a rethrow entry in the new callstack
     QoreListNode* l = e->callStack;
     const char *fn = nullptr;
-    QoreHashNode* n = l->retrieveEntry(0).get<QoreHashNode>();
     // get function name
-    fn = !n ? "<unknown>" : n->getKeyValue("function").get<QoreStringNode>()->c_str();
+    if (!l->empty()) {
+        QoreHashNode* n = l->retrieveEntry(0).get<QoreHashNode>();
+        fn = n->getKeyValue("function").get<QoreStringNode>()->c_str();
+    } else if (!e->frames.empty()) {
+        fn = e->frames[0].code.c_str();
+    } else {
+        fn = "<unknown>";
+    }
 
     l->insert(QoreThreadList::getCallStackHash(CT_RETHROW, fn, *get_runtime_location()), nullptr);
     return e.release();
@@ -135,7 +167,7 @@ QoreException* QoreException::rethrow() {
 
 int QORE_MAX_EXCEPTIONS = 20;
 
-QoreHashNode* QoreException::makeExceptionObject(int level) const {
+QoreHashNode* QoreException::makeExceptionObject(int level, bool with_callstack) const {
     QORE_TRACE("makeExceptionObject()");
 
     QoreHashNode* h = new QoreHashNode(hashdeclExceptionInfo, nullptr);
@@ -151,7 +183,9 @@ QoreHashNode* QoreException::makeExceptionObject(int level) const {
     ph->setKeyValueIntern("source", new QoreStringNode(loc.source));
     ph->setKeyValueIntern("offset", loc.offset);
     ph->setKeyValueIntern("lang", new QoreStringNode(loc.lang));
-    ph->setKeyValueIntern("callstack", callStack->refSelf());
+    if (with_callstack) {
+        ph->setKeyValueIntern("callstack", getCallStack()->refSelf());
+    }
     if (err) {
         ph->setKeyValueIntern("err", err.refSelf());
     }
@@ -165,7 +199,7 @@ QoreHashNode* QoreException::makeExceptionObject(int level) const {
     // add chained exceptions with this "chain reaction" call
     if (next) {
          if (level < QORE_MAX_EXCEPTIONS) {
-             ph->setKeyValueIntern("next", next->makeExceptionObject(level + 1));
+             ph->setKeyValueIntern("next", next->makeExceptionObject(level + 1, with_callstack));
          }
     }
 
@@ -225,6 +259,33 @@ QoreHashNode* QoreException::getStackHash(const QoreCallStackElement& cse) {
     return h.release();
 }
 
+QoreHashNode* QoreException::getStackHash(const QoreExceptionStackFrame& frame) {
+    ReferenceHolder<QoreHashNode> h(new QoreHashNode(hashdeclCallStackInfo, nullptr), nullptr);
+
+    qore_hash_private* ph = qore_hash_private::get(**h);
+
+    ph->setKeyValueIntern("function", new QoreStringNode(frame.code));
+    ph->setKeyValueIntern("line",     frame.start_line);
+    ph->setKeyValueIntern("endline",  frame.end_line);
+    ph->setKeyValueIntern("file",     new QoreStringNode(frame.file));
+    // do not set "source" to NOTHING, as it must have a value according to the CallStackInfo hashdecl
+    if (frame.has_source) {
+        ph->setKeyValueIntern("source", new QoreStringNode(frame.source));
+    }
+    ph->setKeyValueIntern("offset",   frame.offset);
+    ph->setKeyValueIntern("lang",     new QoreStringNode(frame.lang));
+    ph->setKeyValueIntern("typecode", frame.type);
+    ph->setKeyValueIntern("type",     new QoreStringNode(getType(frame.type)));
+    if (frame.has_pgm) {
+        ph->setKeyValueIntern("programid", frame.programid);
+        if (frame.statementid) {
+            ph->setKeyValueIntern("statementid", frame.statementid);
+        }
+    }
+
+    return h.release();
+}
+
 DLLLOCAL ParseExceptionSink::~ParseExceptionSink() {
     if (xsink) {
         qore_program_private::addParseException(getProgram(), xsink);
@@ -48,20 +48,63 @@
 
 static const char* qore_hash_type_name = "hash";
 
+// interned hash keys; keys are stored in the key objects, which are deleted when the last reference is released
+typedef std::map<const char*, QoreHashKey*, ltstr> hash_key_map_t;
+static hash_key_map_t hash_key_map;
+static QoreThreadLock hash_key_lck;
+
+const QoreHashKey* QoreHashKey::get(const char* key) {
+    AutoLocker al(hash_key_lck);
+
+    hash_key_map_t::iterator i = hash_key_map.lower_bound(key);
+    if (i != hash_key_map.end() && !strcmp(i->first, key)) {
+        i->second->ref();
+        return i->second;
+    }
+
+    QoreHashKey* k = new QoreHashKey(key, strlen(key));
+    hash_key_map.insert(i, hash_key_map_t::value_type(k->c_str(), k));
+    return k;
+}
+
+void QoreHashKey::deref() const {
+    unsigned c = refs.load(std::memory_order_relaxed);
+    while (c > 1) {
+        if (refs.compare_exchange_weak(c, c - 1, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+
+    // this may be the last reference; a key without references can only be referenced again by get() with the
+    // lock held
+    AutoLocker al(hash_key_lck);
+    if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // the key is no longer in the map if it was released after delete_hash_keys() was called
+        hash_key_map_t::iterator i = hash_key_map.find(key.c_str());
+        if (i != hash_key_map.end() && i->second == this) {
+            hash_key_map.erase(i);
+        }
+        delete this;
+    }
+}
+
+void delete_hash_keys() {
+    // keys still referenced by hashes, shapes, or parse nodes are deleted when their last reference is released
+    AutoLocker al(hash_key_lck);
+    hash_key_map.clear();
+}
+
 QoreValue qore_hash_private::takeKeyValueIntern(const char* key, qore_object_private* obj) {
     assert(key);
 
-    hm_hm_t::iterator i = hm.find(key);
+    size_t pos = findPos(key);
 
-    if (i == hm.end()) {
+    if (pos == npos) {
         return QoreValue();
     }
 
-    qhlist_t::iterator li = i->second;
-    hm.erase(i);
-
-    QoreValue rv = (*li)->val;
-    internDeleteKey(li);
+    QoreValue rv = member_list[pos]->val;
+    internDeleteKey(pos);
 
     if (needs_scan(rv)) {
         if (obj) {
@@ -78,19 +121,25 @@ QoreValue qore_hash_private::takeKeyValueIntern(const char* key, qore_object_pri
 
 QoreListNode* qore_hash_private::getKeys() const {
     QoreListNode* list = new QoreListNode(stringTypeInfo);
-    qore_list_private::get(*list)->reserve(member_list.size());
+    qore_list_private::get(*list)->reserve(len);
 
     for (auto& i : member_list) {
-        list->push(new QoreStringNode(i->key), nullptr);
+        if (!i) {
+            continue;
+        }
+        list->push(new QoreStringNode(i->getKey(), i->getKeyLen()), nullptr);
     }
     return list;
 }
 
 QoreListNode* qore_hash_private::getValues() const {
     ReferenceHolder<QoreListNode> list(new QoreListNode(getValueTypeInfo()), nullptr);
-    qore_list_private::get(**list)->reserve(member_list.size());
+    qore_list_private::get(**list)->reserve(len);
 
     for (auto& i : member_list) {
+        if (!i) {
+            continue;
+        }
         list->push(i->val.refSelf(), nullptr);
     }
     return list.release();
@@ -98,17 +147,25 @@ QoreListNode* qore_hash_private::getValues() const {
 
 void qore_hash_private::merge(const qore_hash_private& h, ExceptionSink* xsink) {
     for (auto& i : h.member_list) {
-        setKeyValue(i->key, i->val.refSelf(), xsink);
+        if (!i) {
+            continue;
+        }
+        setKeyValue(*i, i->val.refSelf(), xsink);
     }
 }
 
 void qore_hash_private::merge(const qore_hash_private& h, SafeDerefHelper& sdh, ExceptionSink* xsink) {
     for (auto& i : h.member_list) {
-        setKeyValue(i->key, i->val.refSelf(), sdh, xsink);
+        if (!i) {
+            continue;
+        }
+        setKeyValue(*i, i->val.refSelf(), sdh, xsink);
     }
 }
 
-int qore_hash_private::getLValue(const char* key, LValueHelper& lvh, bool for_remove, ExceptionSink* xsink) {
+template <typename T>
+int qore_hash_private::getLValueIntern(const char* key, const T& k, LValueHelper& lvh, bool for_remove,
+        ExceptionSink* xsink) {
     if (checkValid(xsink)) {
         return -1;
     }
@@ -129,15 +186,12 @@ int qore_hash_private::getLValue(const char* key, LValueHelper& lvh, bool for_re
         memTypeInfo = QoreTypeInfo::getUniqueReturnComplexHash(complexTypeInfo);
     }
 
-    hm_hm_t::const_iterator i = hm.find(key);
-    HashMember* m;
-    if (i == hm.end()) {
+    HashMember* m = findMemberIntern(k);
+    if (!m) {
         if (for_remove) {
             return -1;
         }
-        m = findCreateMember(key);
-    } else {
-        m = (*(i->second));
+        m = findCreateMember(k);
     }
 
     //printd(5, "qore_hash_private::getLValue() this: %p hd: %p ct: %p key: '%s' type: '%s'\n", this, hashdecl,
@@ -148,6 +202,14 @@ int qore_hash_private::getLValue(const char* key, LValueHelper& lvh, bool for_re
     return 0;
 }
 
+int qore_hash_private::getLValue(const char* key, LValueHelper& lvh, bool for_remove, ExceptionSink* xsink) {
+    return getLValueIntern(key, key, lvh, for_remove, xsink);
+}
+
+int qore_hash_private::getLValue(const QoreHashKey& key, LValueHelper& lvh, bool for_remove, ExceptionSink* xsink) {
+    return getLValueIntern(key.c_str(), key, lvh, for_remove, xsink);
+}
+
 int qore_hash_private::parseInitHashInitialization(const QoreProgramLocation* loc, QoreParseContext& parse_context,
         QoreParseListNode* args, QoreValue& arg, int& err) {
     assert(!parse_context.typeInfo);
@@ -367,11 +429,11 @@ QoreValue qore_hash_private::getKeyValueExistence(const char* key, bool& exists,
 }
 
 QoreValue qore_hash_private::getKeyValueExistenceIntern(const char* key, bool& exists) const {
-    hm_hm_t::const_iterator i = hm.find(key);
+    HashMember* m = findMemberIntern(key);
 
-    if (i != hm.end()) {
+    if (m) {
         exists = true;
-        return (*i->second)->val;
+        return m->val;
     }
 
     exists = false;
@@ -379,8 +441,8 @@ QoreValue qore_hash_private::getKeyValueExistenceIntern(const char* key, bool& e
 }
 
 QoreValue qore_hash_private::getKeyValueIntern(const char* key) const {
-    hm_hm_t::const_iterator i = hm.find(key);
-    return i != hm.end() ? (*i->second)->val : QoreValue();
+    HashMember* m = findMemberIntern(key);
+    return m ? m->val : QoreValue();
 }
 
 QoreHashNode::QoreHashNode(bool ne) : AbstractQoreNode(NT_HASH, !ne, ne), priv(new qore_hash_private) {
@@ -572,11 +634,11 @@ bool QoreHashNode::compareSoft(const QoreHashNode* h, ExceptionSink* xsink) cons
 
     ConstHashIterator hi(this);
     while (hi.next()) {
-        hm_hm_t::const_iterator j = h->priv->hm.find(hi.getKey());
-        if (j == h->priv->hm.end())
+        HashMember* m = h->priv->findMemberIntern(hi.getKey());
+        if (!m)
             return 1;
 
-        if (!hi.get().isEqualSoft((*j->second)->val, xsink)) {
+        if (!hi.get().isEqualSoft(m->val, xsink)) {
             return 1;
         }
     }
@@ -591,11 +653,11 @@ bool QoreHashNode::compareHard(const QoreHashNode* h, ExceptionSink* xsink) cons
 
     ConstHashIterator hi(this);
     while (hi.next()) {
-        hm_hm_t::const_iterator j = h->priv->hm.find(hi.getKey());
-        if (j == h->priv->hm.end())
+        HashMember* m = h->priv->findMemberIntern(hi.getKey());
+        if (!m)
             return 1;
 
-        if (!hi.get().isEqualHard((*j->second)->val)) {
+        if (!hi.get().isEqualHard(m->val)) {
             return 1;
         }
     }
@@ -792,23 +854,23 @@ QoreHashNode* HashIterator::getHash() const {
 }
 
 QoreValue HashIterator::getReferenced() const {
-    return !priv->valid() ? QoreValue() : (*(priv->i))->val.refSelf();
+    return !priv->valid() ? QoreValue() : priv->m->val.refSelf();
 }
 
 QoreString* HashIterator::getKeyString() const {
-    return !priv->valid() ? nullptr : new QoreString((*(priv->i))->key);
+    return !priv->valid() ? nullptr : new QoreString(priv->m->getKey(), priv->m->getKeyLen());
 }
 
 QoreStringNode* HashIterator::getKeyStringNode() const {
-    return !priv->valid() ? nullptr : new QoreStringNode((*(priv->i))->key);
+    return !priv->valid() ? nullptr : new QoreStringNode(priv->m->getKey(), priv->m->getKeyLen());
 }
 
 bool HashIterator::next() {
-    return h ? priv->next(h->priv->member_list) : false;
+    return h ? priv->next(*h->priv) : false;
 }
 
 bool HashIterator::prev() {
-    return h ? priv->prev(h->priv->member_list) : false;
+    return h ? priv->prev(*h->priv) : false;
 }
 
 const char* HashIterator::getKey() const {
@@ -816,7 +878,7 @@ const char* HashIterator::getKey() const {
         return nullptr;
     }
 
-    return (*(priv->i))->key.c_str();
+    return priv->m->getKey();
 }
 
 QoreValue HashIterator::get() const {
@@ -824,7 +886,7 @@ QoreValue HashIterator::get() const {
         return QoreValue();
     }
 
-    return (*(priv->i))->val;
+    return priv->m->val;
 }
 
 const QoreTypeInfo* HashIterator::getTypeInfo() const {
@@ -832,7 +894,7 @@ const QoreTypeInfo* HashIterator::getTypeInfo() const {
         return nullptr;
     }
 
-    return (*(priv->i))->val.getTypeInfo();
+    return priv->m->val.getTypeInfo();
 }
 
 void HashIterator::deleteKey(ExceptionSink* xsink) {
@@ -842,19 +904,17 @@ void HashIterator::deleteKey(ExceptionSink* xsink) {
 
     assert(h->is_unique());
 
-    if (needs_scan((*(priv->i))->val)) {
+    if (needs_scan(priv->m->val)) {
         h->priv->incScanCount(-1);
     }
 
-    (*(priv->i))->val.discard(xsink);
+    priv->m->val.discard(xsink);
 
-    qhlist_t::iterator ni = priv->i;
-    priv->prev(h->priv->member_list);
+    priv->sync(*h->priv);
+    size_t pos = priv->i;
+    priv->prev(*h->priv);
 
-    hm_hm_t::iterator i = h->priv->hm.find((*ni)->key.c_str());
-    assert(i != h->priv->hm.end());
-    h->priv->hm.erase(i);
-    h->priv->internDeleteKey(ni);
+    h->priv->internDeleteKey(pos);
 }
 
 int HashIterator::assign(QoreValue val, ExceptionSink* xsink) {
@@ -865,7 +925,7 @@ int HashIterator::assign(QoreValue val, ExceptionSink* xsink) {
 
     assert(h->is_unique());
 
-    hash_assignment_priv ha(*h->priv, *(priv->i));
+    hash_assignment_priv ha(*h->priv, priv->m);
     ha.assign(val, xsink);
 
     return *xsink ? -1 : 0;
@@ -877,19 +937,17 @@ QoreValue HashIterator::removeKeyValue() {
 
     assert(h->is_unique());
 
-    QoreValue rv = (*(priv->i))->val;
+    QoreValue rv = priv->m->val;
 
     if (needs_scan(rv)) {
         h->priv->incScanCount(-1);
     }
 
-    qhlist_t::iterator ni = priv->i;
-    priv->prev(h->priv->member_list);
+    priv->sync(*h->priv);
+    size_t pos = priv->i;
+    priv->prev(*h->priv);
 
-    hm_hm_t::iterator i = h->priv->hm.find((*ni)->key.c_str());
-    assert(i != h->priv->hm.end());
-    h->priv->hm.erase(i);
-    h->priv->internDeleteKey(ni);
+    h->priv->internDeleteKey(pos);
 
     return rv;
 }
@@ -898,16 +956,14 @@ bool HashIterator::last() const {
     if (!priv->valid())
         return false;
 
-    qhlist_t::const_iterator ni = priv->i;
-    ++ni;
-    return ni == h->priv->member_list.end() ? true : false;
+    return priv->last(*h->priv);
 }
 
 bool HashIterator::first() const {
     if (!priv->valid())
         return false;
 
-    return priv->i == h->priv->member_list.begin();
+    return priv->first(*h->priv);
 }
 
 bool HashIterator::empty() const {
@@ -962,59 +1018,57 @@ const QoreHashNode* ConstHashIterator::getHash() const {
 }
 
 QoreValue ConstHashIterator::getReferenced() const {
-    return !priv->valid() ? QoreValue() : (*(priv->i))->val.refSelf();
+    return !priv->valid() ? QoreValue() : priv->m->val.refSelf();
 }
 
 QoreString* ConstHashIterator::getKeyString() const {
-   return !priv->valid() ? nullptr : new QoreString((*(priv->i))->key);
+   return !priv->valid() ? nullptr : new QoreString(priv->m->getKey(), priv->m->getKeyLen());
 }
 
 QoreStringNode* ConstHashIterator::getKeyStringNode() const {
-    return !priv->valid() ? nullptr : new QoreStringNode((*(priv->i))->key);
+    return !priv->valid() ? nullptr : new QoreStringNode(priv->m->getKey(), priv->m->getKeyLen());
 }
 
 bool ConstHashIterator::next() {
-   return h ? priv->next(h->priv->member_list) : false;
+   return h ? priv->next(*h->priv) : false;
 }
 
 bool ConstHashIterator::prev() {
-   return h ? priv->prev(h->priv->member_list) : false;
+   return h ? priv->prev(*h->priv) : false;
 }
 
 const char* ConstHashIterator::getKey() const {
    if (!priv->valid())
       return 0;
-   return (*(priv->i))->key.c_str();
+   return priv->m->getKey();
 }
 
 const QoreValue ConstHashIterator::get() const {
     if (!priv->valid())
         return QoreValue();
 
-    return (*(priv->i))->val;
+    return priv->m->val;
 }
 
 const QoreTypeInfo* ConstHashIterator::getTypeInfo() const {
     if (!priv->valid())
         return nullptr;
 
-    return (*(priv->i))->val.getTypeInfo();
+    return priv->m->val.getTypeInfo();
 }
 
 bool ConstHashIterator::last() const {
    if (!priv->valid())
       return false;
 
-   qhlist_t::const_iterator ni = priv->i;
-   ++ni;
-   return ni == h->priv->member_list.end() ? true : false;
+   return priv->last(*h->priv);
 }
 
 bool ConstHashIterator::first() const {
    if (!priv->valid())
       return false;
 
-   return priv->i == h->priv->member_list.begin();
+   return priv->first(*h->priv);
 }
 
 bool ConstHashIterator::empty() const {
@@ -1090,7 +1144,7 @@ void hash_assignment_priv::reassign(const char* key, bool must_already_exist) {
 }
 
 const char* hash_assignment_priv::getKey() const {
-    return om ? om->key.c_str() : nullptr;
+    return om ? om->getKey() : nullptr;
 }
 
 QoreValue hash_assignment_priv::swapImpl(QoreValue v) {
@@ -1120,11 +1174,11 @@ QoreValue hash_assignment_priv::swapImpl(QoreValue v) {
 void hash_assignment_priv::assign(QoreValue v, ExceptionSink* xsink) {
     ValueHolder val(v, xsink);
     if (h.hashdecl) {
-        if (typed_hash_decl_private::get(*h.hashdecl)->runtimeAssignKey(om->key.c_str(), val, xsink)) {
+        if (typed_hash_decl_private::get(*h.hashdecl)->runtimeAssignKey(om->getKey(), val, xsink)) {
             return;
         }
     } else if (h.complexTypeInfo) {
-        QoreTypeInfo::acceptInputKey(QoreTypeInfo::getUniqueReturnComplexHash(h.complexTypeInfo), om->key.c_str(),
+        QoreTypeInfo::acceptInputKey(QoreTypeInfo::getUniqueReturnComplexHash(h.complexTypeInfo), om->getKey(),
             *val, xsink);
         // allow this function to be called with xsink = nullptr, otherwise the *xsink will assert
         // anyway if there is an exception it would dump core when the exception is raised
@@ -1143,11 +1197,11 @@ void hash_assignment_priv::assign(QoreValue v, ExceptionSink* xsink) {
 void hash_assignment_priv::assign(QoreValue v, SafeDerefHelper& sdh, ExceptionSink* xsink) {
     ValueHolder val(v, xsink);
     if (h.hashdecl) {
-        if (typed_hash_decl_private::get(*h.hashdecl)->runtimeAssignKey(om->key.c_str(), val, xsink)) {
+        if (typed_hash_decl_private::get(*h.hashdecl)->runtimeAssignKey(om->getKey(), val, xsink)) {
             return;
         }
     } else if (h.complexTypeInfo) {
-        QoreTypeInfo::acceptInputKey(QoreTypeInfo::getUniqueReturnComplexHash(h.complexTypeInfo), om->key.c_str(),
+        QoreTypeInfo::acceptInputKey(QoreTypeInfo::getUniqueReturnComplexHash(h.complexTypeInfo), om->getKey(),
             *val, xsink);
         // allow this function to be called with xsink = nullptr, otherwise the *xsink will assert
         // anyway if there is an exception it would dump core when the exception is raised
@@ -1194,7 +1248,7 @@ HashAssignmentHelper::HashAssignmentHelper(ExceptionSink* xsink, QoreHashNode& h
 }
 
 HashAssignmentHelper::HashAssignmentHelper(HashIterator &hi)
-        : priv(new hash_assignment_priv(*hi.h->priv, *(hi.priv->i))) {
+        : priv(new hash_assignment_priv(*hi.h->priv, hi.priv->m)) {
 }
 
 HashAssignmentHelper::~HashAssignmentHelper() {
@@ -31,10 +31,17 @@
 #include <qore/Qore.h>
 #include "qore/intern/qore_program_private.h"
 #include "qore/intern/QoreClassIntern.h"
+#include "qore/intern/QoreHashNodeIntern.h"
 #include "qore/intern/typed_hash_decl_private.h"
 
 QoreString QoreHashObjectDereferenceOperatorNode::op_str(". or {} operator expression");
 
+QoreHashObjectDereferenceOperatorNode::~QoreHashObjectDereferenceOperatorNode() {
+    if (key) {
+        key->deref();
+    }
+}
+
 int QoreHashObjectDereferenceOperatorNode::parseInitImpl(QoreValue& val, QoreParseContext& parse_context) {
     // turn off "return value ignored" flags
     QoreParseContextFlagHelper fh(parse_context);
@@ -194,6 +201,23 @@ int QoreHashObjectDereferenceOperatorNode::parseInitImpl(QoreValue& val, QorePar
         rti->doNonStringWarning(loc, "the right side of the expression with the '.' or '{}' operator is ");
     }
 
+    // resolve the key at parse time if possible
+    if (right.getType() == NT_STRING) {
+        const QoreStringNode* str = right.get<const QoreStringNode>();
+        if (str->getEncoding() == QCS_DEFAULT) {
+            key = QoreHashKey::get(str->c_str());
+        }
+
+        // record member reads from local variables
+        if (!for_assignment && left.getType() == NT_VARREF) {
+            const VarRefNode* v = left.get<const VarRefNode>();
+            qore_var_t t = v->getType();
+            if (t == VT_LOCAL || t == VT_CLOSURE || t == VT_LOCAL_TS) {
+                v->ref.id->parseMemberRead(str->c_str());
+            }
+        }
+    }
+
     typeInfo = parse_context.typeInfo;
     return err;
 }
@@ -202,6 +226,12 @@ QoreValue QoreHashObjectDereferenceOperatorNode::evalImpl(bool& needs_deref, Exc
     ValueEvalOptimizedRefHolder lh(left, xsink);
     if (*xsink)
         return QoreValue();
+
+    if (key && lh->getType() == NT_HASH) {
+        QoreValue v = qore_hash_private::get(*lh->get<const QoreHashNode>())->getKeyValue(*key, xsink);
+        return *xsink ? QoreValue() : v.refSelf();
+    }
+
     ValueEvalOptimizedRefHolder rh(right, xsink);
     if (*xsink)
         return QoreValue();
@@ -104,6 +104,8 @@ const QoreProgramLocation loc_builtin("<builtin>", -1, -1);
 QoreString random_salt;
 
 DLLLOCAL bool q_disable_gc = false;
+DLLLOCAL bool q_background_gc = false;
+DLLLOCAL bool q_background_thread_pool = false;
 
 // issue #3045: module options
 DLLLOCAL QoreThreadLock mod_opt_lock;
@@ -2912,7 +2914,7 @@ void QorePossibleListNodeParseInitHelper::parseInit(QoreParseContext& parse_cont
     } else if (l) {
         assert(!pl);
         // return element type
-        parse_context.typeInfo = qore_list_private::get(*l)->getEntryReference(pos).getFullTypeInfo();
+        parse_context.typeInfo = l->retrieveEntry(pos).getFullTypeInfo();
     } else {
         assert(pl);
         assert(!l);
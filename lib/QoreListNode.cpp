@@ -36,12 +36,15 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
 #define LIST_BLOCK 20
 #define LIST_PAD   15
+// maximum entry buffer size for lists recycled with qore_list_private::derefEvalList()
+#define QORE_EVAL_LIST_RECYCLE_SIZE (LIST_PAD + 1)
 
 #ifndef QORE_QUICKSORT_LIMIT
 #define QORE_QUICKSORT_LIMIT 1000
@@ -55,6 +58,108 @@ static QoreListNode* do_args(const QoreValue& e1, const QoreValue& e2) {
     return l;
 }
 
+// the loops below are kept simple so that the compiler can vectorize them
+template <typename T>
+static T packed_min(const T* v, size_t len) {
+    T rv = v[0];
+    for (size_t i = 1; i < len; ++i) {
+        rv = v[i] < rv ? v[i] : rv;
+    }
+    return rv;
+}
+
+template <typename T>
+static T packed_max(const T* v, size_t len) {
+    T rv = v[0];
+    for (size_t i = 1; i < len; ++i) {
+        rv = v[i] > rv ? v[i] : rv;
+    }
+    return rv;
+}
+
+// stable, like the mergesort used for boxed elements, so that 0.0 and -0.0 keep their order
+template <typename T>
+static void packed_sort(T* v, size_t len, bool ascending) {
+    if (ascending) {
+        std::stable_sort(v, v + len, [](T a, T b) { return a < b; });
+    } else {
+        std::stable_sort(v, v + len, [](T a, T b) { return a > b; });
+    }
+}
+
+bool qore_list_private::sortPacked(bool ascending) {
+    // bool elements are stored as 0 or 1, so they sort like the boxed values
+    if (packed_type != NT_FLOAT) {
+        packed_sort(getPackedInts(), length, ascending);
+        return true;
+    }
+    double* v = getPackedFloats();
+    // NaN values are unordered; such lists are sorted with the generic algorithm
+    if (std::any_of(v, v + length, [](double d) { return std::isnan(d); })) {
+        return false;
+    }
+    packed_sort(v, length, ascending);
+    return true;
+}
+
+void qore_list_buffer::deref(ExceptionSink* xsink) {
+    if (!refs.ROdereference()) {
+        return;
+    }
+    if (!packed_type) {
+        QoreValue* e = static_cast<QoreValue*>(data);
+        for (size_t i = 0, n = used; i < n; ++i) {
+            e[i].discard(xsink);
+        }
+    }
+    free(data);
+    delete this;
+}
+
+void qore_list_private::detach(size_t num) {
+    qore_list_buffer* b = shared;
+    if (!b) {
+        return;
+    }
+    if (num < length) {
+        num = length;
+    }
+    if (b->refs.is_unique() && num < b->allocated) {
+        // no other list uses the buffer; take over its storage and drop elements appended by other lists
+        if (!packed_type) {
+            for (size_t i = length, e = b->used; i < e; ++i) {
+                entry[i].discard(nullptr);
+            }
+        }
+        shared = nullptr;
+        b->data = nullptr;
+        delete b;
+        return;
+    }
+
+    size_t d = num >> 2;
+    size_t n_allocated = num + (d < LIST_PAD ? LIST_PAD : d);
+    if (packed_type) {
+        void* p = malloc(sizeof(int64) * n_allocated);
+        memcpy(p, packed, sizeof(int64) * length);
+        packed = p;
+    } else {
+#pragma GCC diagnostic ignored "-Wclass-memaccess"
+        QoreValue* e = (QoreValue*)malloc(sizeof(QoreValue) * n_allocated);
+#pragma GCC diagnostic pop
+        for (size_t i = 0; i < length; ++i) {
+            new (&e[i]) QoreValue(entry[i].refSelf());
+        }
+        entry = e;
+    }
+    allocated = n_allocated;
+    releaseShared(nullptr);
+}
+
+void QoreListNodeEvalOptionalRefHolder::derefIntern() {
+    qore_list_private::derefEvalList(val, xsink);
+}
+
 QoreValue& QoreListNodeEvalOptionalRefHolder::getEntryReference(size_t index) {
     editIntern();
     return qore_list_private::get(*val)->getEntryReference(index);
@@ -70,7 +175,7 @@ void QoreListNodeEvalOptionalRefHolder::evalIntern(QoreListNode* exp) {
         return;
     }
     needs_deref = true;
-    val = new QoreListNode(autoTypeInfo);
+    val = qore_list_private::getEvalList(qore_get_complex_list_type(autoTypeInfo));
     qore_list_private* vl = qore_list_private::get(*val);
     vl->reserve(exp->size());
 
@@ -95,6 +200,7 @@ int qore_list_private::getLValue(size_t ind, LValueHelper& lvh, bool for_remove,
         return -1;
     }
 
+    makeWritable();
     if (ind >= length) {
         resize(ind + 1);
     }
@@ -299,6 +405,7 @@ QoreListNode* qore_list_private::newComplexListFromValue(const QoreTypeInfo* typ
     // mark new hash with new type
     assert(l->is_unique());
     l->priv->complexTypeInfo = typeInfo;
+    l->priv->pack();
     return holder.release().get<QoreListNode>();
 }
 
@@ -365,28 +472,28 @@ const QoreValue QoreListNode::retrieveEntry(size_t num) const {
     if (num >= priv->length) {
         return QoreValue();
     }
-    return priv->entry[num];
+    return priv->getValue(num);
 }
 
 QoreValue QoreListNode::retrieveEntry(size_t num) {
     if (num >= priv->length) {
         return QoreValue();
     }
-    return priv->entry[num];
+    return priv->getValue(num);
 }
 
 QoreValue QoreListNode::getReferencedEntry(size_t num) const {
     if (num >= priv->length) {
         return QoreValue();
     }
-    return priv->entry[num].refSelf();
+    return priv->getValue(num).refSelf();
 }
 
 int QoreListNode::getEntryAsInt(size_t num) const {
     if (num >= priv->length) {
         return 0;
     }
-    return (int)priv->entry[num].getAsBigInt();
+    return (int)priv->getValue(num).getAsBigInt();
 }
 
 int QoreListNode::merge(const QoreListNode* list, ExceptionSink* xsink) {
@@ -395,6 +502,12 @@ int QoreListNode::merge(const QoreListNode* list, ExceptionSink* xsink) {
 
 int QoreListNode::setEntry(size_t index, QoreValue val, ExceptionSink* xsink) {
     assert(reference_count() == 1);
+    if (priv->packed_type && index < priv->length && val.getType() == priv->packed_type) {
+        priv->detach();
+        priv->setPacked(index, val);
+        return 0;
+    }
+    priv->makeWritable();
     if (index >= priv->length) {
         priv->resize(index + 1);
     }
@@ -425,6 +538,7 @@ int QoreListNode::insert(QoreValue val, ExceptionSink* xsink) {
         return -1;
     }
 
+    priv->makeWritable();
     priv->resize(priv->length + 1);
     if (priv->length - 1) {
         memmove(priv->entry + 1, priv->entry, sizeof(QoreValue) * (priv->length - 1));
@@ -443,6 +557,14 @@ QoreValue QoreListNode::shift() {
     if (!priv->length) {
         return QoreValue();
     }
+    if (priv->packed_type) {
+        priv->detach();
+        QoreValue rv = priv->getValue(0);
+        memmove(priv->packed, static_cast<int64*>(priv->packed) + 1, sizeof(int64) * (priv->length - 1));
+        priv->resize(priv->length - 1);
+        return rv;
+    }
+    priv->makeWritable();
     QoreValue rv = priv->entry[0];
     size_t pos = priv->length - 1;
     memmove(priv->entry, priv->entry + 1, sizeof(QoreValue) * pos);
@@ -462,6 +584,12 @@ QoreValue QoreListNode::pop() {
     if (!priv->length) {
         return QoreValue();
     }
+    // removing the last element does not modify packed or shared storage; shared elements are referenced
+    if (priv->packed_type || priv->shared) {
+        QoreValue rv = priv->getValue(priv->length - 1).refSelf();
+        priv->resize(priv->length - 1);
+        return rv;
+    }
     QoreValue rv = priv->entry[priv->length - 1];
     size_t pos = priv->length - 1;
     priv->entry[pos] = QoreValue();
@@ -507,7 +635,7 @@ QoreListNode* QoreListNode::copy() const {
 QoreListNode* QoreListNode::copyListFrom(size_t index) const {
     QoreListNode* nl = priv->getCopy();
     for (size_t i = index; i < priv->length; ++i) {
-        nl->priv->pushIntern(priv->entry[i].refSelf());
+        nl->priv->pushIntern(priv->getValue(i).refSelf());
     }
 
     return nl;
@@ -624,10 +752,10 @@ QoreListNode* QoreListNode::sortDescending(const ResolvedCallReferenceNode* fr,
 }
 
 QoreListNode* qore_list_private::eval(ExceptionSink* xsink) {
-    ReferenceHolder<QoreListNode> nl(getCopy(), xsink);
+    ReferenceHolder<QoreListNode> nl(getEvalList(complexTypeInfo), xsink);
     //printd(5, "qore_list_private::eval() '%s' -> '%s'\n", QoreTypeInfo::getName(complexTypeInfo), get_full_type_name(*nl));
     for (size_t i = 0; i < length; ++i) {
-        ValueEvalOptimizedRefHolder v(entry[i], xsink);
+        ValueEvalOptimizedRefHolder v(getValue(i), xsink);
         if (*xsink) {
             return nullptr;
         }
@@ -638,6 +766,34 @@ QoreListNode* qore_list_private::eval(ExceptionSink* xsink) {
     return nl.release();
 }
 
+QoreListNode* qore_list_private::getEvalList(const QoreTypeInfo* complexTypeInfo) {
+    QoreListNode* l = get_thread_eval_list();
+    if (!l) {
+        l = new QoreListNode;
+    }
+    l->priv->complexTypeInfo = complexTypeInfo;
+    return l;
+}
+
+void qore_list_private::derefEvalList(QoreListNode* l, ExceptionSink* xsink) {
+    qore_list_private* p = l->priv;
+    // only plain lists with a small entry buffer are recycled; the entry buffer is kept for reuse, so lists with
+    // packed storage are not recycled
+    if (l->is_unique() && l->is_value() && p->valid && !p->finalized && !p->vlist && !p->packed_type
+        && p->allocated <= QORE_EVAL_LIST_RECYCLE_SIZE && !p->shared && p->weakRefs.reference_count() == 1) {
+        for (size_t i = 0; i < p->length; ++i) {
+            p->entry[i].discard(xsink);
+        }
+        p->length = 0;
+        p->obj_count = 0;
+        p->complexTypeInfo = nullptr;
+        if (put_thread_eval_list(l)) {
+            return;
+        }
+    }
+    l->deref(xsink);
+}
+
 // mergesort for controlled and interruptible sorts (stable)
 int qore_list_private::mergesort(const ResolvedCallReferenceNode* fr, bool ascending, ExceptionSink* xsink) {
     //printd(5, "List::mergesort() ENTER this: %p, pgm: %p, f: %p length: %d\n", this, pgm, f, length);
@@ -646,6 +802,14 @@ int qore_list_private::mergesort(const ResolvedCallReferenceNode* fr, bool ascen
         return 0;
     }
 
+    if (packed_type && !fr) {
+        detach();
+        if (sortPacked(ascending)) {
+            return 0;
+        }
+    }
+    makeWritable();
+
     // separate list into two equal-sized lists
     ReferenceHolder<QoreListNode> left(new QoreListNode(autoTypeInfo), xsink);
     ReferenceHolder<QoreListNode> right(new QoreListNode(autoTypeInfo), xsink);
@@ -723,6 +887,16 @@ int qore_list_private::qsort(const ResolvedCallReferenceNode* fr, size_t left, s
     }
 #endif
 
+    if (packed_type && !fr) {
+        // packed lists are only sorted as a whole
+        assert(!left && right == length - 1);
+        detach();
+        if (sortPacked(ascending)) {
+            return 0;
+        }
+    }
+    makeWritable();
+
     size_t l_hold = left;
     size_t r_hold = right;
     QoreValue pivot = entry[left];
@@ -865,8 +1039,15 @@ QoreListNode* QoreListNode::sortStable(const ResolvedCallReferenceNode* fr, Exce
 
 // does a deep dereference
 bool QoreListNode::derefImpl(ExceptionSink* xsink) {
-    for (size_t i = 0; i < priv->length; ++i) {
-        priv->entry[i].discard(xsink);
+    if (priv->shared) {
+        priv->releaseShared(xsink);
+        priv->entry = nullptr;
+        priv->packed = nullptr;
+    } else if (!priv->packed_type) {
+        // packed elements need no dereferencing
+        for (size_t i = 0; i < priv->length; ++i) {
+            priv->entry[i].discard(xsink);
+        }
     }
 #ifdef DEBUG
     priv->length = 0;
@@ -888,6 +1069,16 @@ QoreValue QoreListNode::min(ExceptionSink* xsink) const {
     if (!priv->length) {
         return QoreValue();
     }
+    switch (priv->packed_type) {
+        case NT_INT:
+            return packed_min(priv->getPackedInts(), priv->length);
+        case NT_FLOAT:
+            return packed_min(priv->getPackedFloats(), priv->length);
+        case NT_BOOLEAN:
+            return packed_min(priv->getPackedInts(), priv->length) != 0;
+        default:
+            break;
+    }
     QoreValue rv = priv->entry[0];
 
     for (size_t i = 1; i < priv->length; ++i) {
@@ -906,6 +1097,16 @@ QoreValue QoreListNode::max(ExceptionSink* xsink) const {
     if (!priv->length) {
         return QoreValue();
     }
+    switch (priv->packed_type) {
+        case NT_INT:
+            return packed_max(priv->getPackedInts(), priv->length);
+        case NT_FLOAT:
+            return packed_max(priv->getPackedFloats(), priv->length);
+        case NT_BOOLEAN:
+            return packed_max(priv->getPackedInts(), priv->length) != 0;
+        default:
+            break;
+    }
     QoreValue rv = priv->entry[0];
 
     for (size_t i = 0; i < priv->length; ++i) {
@@ -925,10 +1126,10 @@ QoreValue QoreListNode::min(const ResolvedCallReferenceNode* fr, ExceptionSink*
     if (!priv->length) {
         return QoreValue();
     }
-    QoreValue rv = priv->entry[0];
+    QoreValue rv = priv->getValue(0);
 
     for (size_t i = 1; i < priv->length; ++i) {
-        QoreValue v = priv->entry[i];
+        QoreValue v = priv->getValue(i);
 
         safe_qorelist_t args(do_args(v, rv), xsink);
         ValueHolder result(fr->execValue(*args, xsink), xsink);
@@ -946,10 +1147,10 @@ QoreValue QoreListNode::max(const ResolvedCallReferenceNode* fr, ExceptionSink*
     if (!priv->length) {
         return QoreValue();
     }
-    QoreValue rv = priv->entry[0];
+    QoreValue rv = priv->getValue(0);
 
     for (size_t i = 1; i < priv->length; ++i) {
-        QoreValue v = priv->entry[i];
+        QoreValue v = priv->getValue(i);
 
         safe_qorelist_t args(do_args(v, rv), xsink);
         ValueHolder result(fr->execValue(*args, xsink), xsink);
@@ -965,6 +1166,18 @@ QoreValue QoreListNode::max(const ResolvedCallReferenceNode* fr, ExceptionSink*
 
 QoreListNode* QoreListNode::reverse() const {
     QoreListNode* l = priv->getCopy();
+    if (priv->packed_type) {
+        qore_list_private* lp = l->priv;
+        lp->initPacked(priv->packed_type);
+        lp->reserve(priv->length);
+        const int64* src = static_cast<const int64*>(priv->packed);
+        int64* dst = static_cast<int64*>(lp->packed);
+        for (size_t i = 0; i < priv->length; ++i) {
+            dst[i] = src[priv->length - i - 1];
+        }
+        lp->length = priv->length;
+        return l;
+    }
     l->priv->resize(priv->length);
     for (size_t i = 0; i < priv->length; ++i) {
         l->priv->entry[i] = priv->entry[priv->length - i - 1].refSelf();
@@ -1010,7 +1223,7 @@ int QoreListNode::getAsString(QoreString &str, int foff, ExceptionSink* xsink) c
             str.sprintf("[%lu]=", i);
         }
 
-        QoreValue n = priv->entry[i];
+        QoreValue n = priv->getValue(i);
         if (n.getAsString(str, foff != FMT_NONE ? foff + 2 : foff, xsink)) {
             return -1;
         }
@@ -179,7 +179,9 @@ QoreValue QoreMapOperatorNode::evalImpl(bool& needs_deref, ExceptionSink* xsink)
     }
 
     if (rv && vcommon && QoreTypeInfo::hasType(vtype)) {
-        qore_list_private::get(**rv)->complexTypeInfo = qore_get_complex_list_type(vtype);
+        qore_list_private* lp = qore_list_private::get(**rv);
+        lp->complexTypeInfo = qore_get_complex_list_type(vtype);
+        lp->pack();
     }
 
     return rv.release();
@@ -45,6 +45,7 @@ qore_object_private::qore_object_private(QoreObject* n_obj, const QoreClass* oc,
         theclass(oc), data(n_data), pgm(p), system_object(!p),
         in_destructor(false),
         recursive_ref_found(false),
+        cycle_free(qore_class_private::get(*oc)->isCycleFree()),
         obj(n_obj) {
     //printd(5, "qore_object_private::qore_object_private() this: %p obj: %p '%s'\n", this, obj, oc->getName());
 #ifdef QORE_DEBUG_OBJ_REFS
@@ -77,6 +78,7 @@ qore_object_private::~qore_object_private() {
     assert(!data);
     assert(!privateData);
     assert(!rset);
+    delete gate.load(std::memory_order_relaxed);
     qore_class_private::get(*const_cast<QoreClass*>(theclass))->deref(false, false);
     // release weak reference
     if (pgm) {
@@ -701,10 +703,10 @@ QoreValue& qore_object_private::getMemberValueRefForInitialization(const char* m
     return qore_hash_private::get(*odata)->getValueRef(member);
 }
 
-int qore_object_private::getLValue(const char* key, LValueHelper& lvh, const qore_class_private* class_ctx, bool for_remove, ExceptionSink* xsink) {
+int qore_object_private::getLValue(const char* key, LValueHelper& lvh, const qore_class_private* class_ctx, bool for_remove, ExceptionSink* xsink, const QoreMemberInfoCache* mcache) {
     const QoreTypeInfo* mti = nullptr;
     const qore_class_private* member_class_ctx = nullptr;
-    if (checkMemberAccessGetTypeInfo(xsink, key, class_ctx, member_class_ctx, mti)) {
+    if (checkMemberAccessGetTypeInfo(xsink, key, class_ctx, member_class_ctx, mti, mcache)) {
         return -1;
     }
 
@@ -736,9 +738,15 @@ int qore_object_private::getLValue(const char* key, LValueHelper& lvh, const qor
     return 0;
 }
 
-QoreValue qore_object_private::getReferencedMemberNoMethod(const char* mem, ExceptionSink* xsink) const {
+QoreValue qore_object_private::getReferencedMemberNoMethod(const char* mem, ExceptionSink* xsink, const QoreMemberInfoCache* mcache) const {
     const qore_class_private* class_ctx = runtime_get_class();
-    const qore_class_private* member_class_ctx = qore_class_private::get(*theclass)->runtimeGetMemberContext(mem, class_ctx);
+    const qore_class_private* member_class_ctx;
+    if (mcache) {
+        const QoreMemberInfo* info = mcache->get(qore_class_private::get(*theclass), mem, class_ctx);
+        member_class_ctx = info ? info->getClassContext(class_ctx) : nullptr;
+    } else {
+        member_class_ctx = qore_class_private::get(*theclass)->runtimeGetMemberContext(mem, class_ctx);
+    }
 
     QoreSafeVarRWReadLocker sl(rml);
 
@@ -775,6 +783,8 @@ void qore_object_private::setValueIntern(const qore_class_private* class_ctx, co
     // initial count (true = possible recursive cycle, false = no cycle possible)
     bool before;
     bool after = needs_scan(val);
+    // set if an object of a cycle-free class is assigned, which would otherwise require a scan
+    bool scan_avoided = !after && is_cycle_free_object(val.getInternalNode());
 
     {
         QoreSafeVarRWWriteLocker sl(rml);
@@ -809,7 +819,9 @@ void qore_object_private::setValueIntern(const qore_class_private* class_ctx, co
 
     // scan object if necessary
     if (before || after)
-        RSetHelper rsh(*this);
+        RSetHelper::scan(*this);
+    else if (scan_avoided)
+        q_inc_thread_stat(QSTAT_OBJECT_SCANS_AVOIDED);
 }
 
 QoreValue qore_object_private::evalBuiltinMethodWithPrivateData(const QoreMethod& method,
@@ -1002,6 +1014,10 @@ void qore_object_private::customDeref(ExceptionSink* xsink, bool real) {
                 }
                 if (recalc) {
                     if (qodh.doScan()) {
+                        // if queued, the object will be dereferenced again after the rset has been recalculated
+                        if (q_background_gc && queueScan()) {
+                            return;
+                        }
                         // recalculate rset immediately
                         RSetHelper rsh(*this);
                         continue;
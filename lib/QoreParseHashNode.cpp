@@ -34,6 +34,8 @@
 #include "qore/intern/QoreHashNodeIntern.h"
 #include "qore/intern/qore_program_private.h"
 
+#include <set>
+
 void QoreParseHashNode::finalizeBlock(int sline, int eline) {
     QoreProgramLocation tl(sline, eline);
     if (tl.getFile() == loc->getFile()
@@ -43,6 +45,22 @@ void QoreParseHashNode::finalizeBlock(int sline, int eline) {
     }
 }
 
+void QoreParseHashNode::refInternedKeys() const {
+    for (const QoreHashKey* k : ikeys) {
+        if (k) {
+            k->ref();
+        }
+    }
+}
+
+void QoreParseHashNode::derefInternedKeys() const {
+    for (const QoreHashKey* k : ikeys) {
+        if (k) {
+            k->deref();
+        }
+    }
+}
+
 int QoreParseHashNode::parseInitImpl(QoreValue& val, QoreParseContext& parse_context) {
     assert(keys.size() == values.size());
     bool needs_eval = false;
@@ -53,8 +71,9 @@ int QoreParseHashNode::parseInitImpl(QoreValue& val, QoreParseContext& parse_con
 
     assert(!parse_context.typeInfo);
 
-    // initialize value type vector
+    // initialize value type and interned key vectors
     vtypes.resize(keys.size());
+    ikeys.resize(keys.size());
 
     // try to find a common value type, if any
     bool vcommon = false;
@@ -69,6 +88,13 @@ int QoreParseHashNode::parseInitImpl(QoreValue& val, QoreParseContext& parse_con
         }
         const QoreTypeInfo* argTypeInfo = parse_context.typeInfo;
 
+        if (keys[i].getType() == NT_STRING) {
+            const QoreStringNode* str = keys[i].get<const QoreStringNode>();
+            if (str->getEncoding() == QCS_DEFAULT) {
+                ikeys[i] = QoreHashKey::get(str->c_str());
+            }
+        }
+
         if (!p.isEqualValue(keys[i]) && (!keys[i] || keys[i].isValue())) {
             QoreStringValueHelper key(keys[i]);
             checkDup(lvec[i], key->c_str());
@@ -112,6 +138,23 @@ int QoreParseHashNode::parseInitImpl(QoreValue& val, QoreParseContext& parse_con
 
     kmap.clear();
 
+    // create the key layout for the hash if all keys are unique string literals
+    if (!keys.empty()) {
+        std::set<const QoreHashKey*> kset;
+        for (const QoreHashKey* k : ikeys) {
+            if (!k || !kset.insert(k).second) {
+                kset.clear();
+                break;
+            }
+        }
+        if (!kset.empty()) {
+            for (const QoreHashKey* k : ikeys) {
+                k->ref();
+            }
+            shape = std::make_shared<const QoreHashShape>(ikvec_t(ikeys));
+        }
+    }
+
     // issue #2791: when performing type folding, do not set to type "any" but rather use "auto"
     if (vtype && vtype != anyTypeInfo) {
         typeInfo = parse_context.typeInfo = qore_get_complex_hash_type(vtype);
@@ -150,6 +193,11 @@ QoreValue QoreParseHashNode::evalImpl(bool& needs_deref, ExceptionSink* xsink) c
     assert(keys.size() == values.size());
     // complex type will be added before returning if applicable
     ReferenceHolder<QoreHashNode> h(new QoreHashNode(autoTypeInfo), xsink);
+    qore_hash_private* hp = qore_hash_private::get(**h);
+    // the members for all keys are created in order before the values are evaluated
+    if (shape) {
+        hp->initShape(*shape);
+    }
 
     // issue #2106 we must calculate the runtime type again because lvalues can return NOTHING despite their declared
     // type
@@ -187,7 +235,15 @@ QoreValue QoreParseHashNode::evalImpl(bool& needs_deref, ExceptionSink* xsink) c
             QoreTypeInfo::acceptInputKey(this->vtype, key->c_str(), val, xsink);
         }
 
-        h->setKeyValue(key->c_str(), val, xsink);
+        // members created with interned keys share the key string
+        if (shape) {
+            hash_assignment_priv ha(*hp, hp->member_list[i]);
+            ha.assign(val, xsink);
+        } else if (i < ikeys.size() && ikeys[i]) {
+            hp->setKeyValue(*ikeys[i], val, xsink);
+        } else {
+            h->setKeyValue(key->c_str(), val, xsink);
+        }
         if (xsink && *xsink) {
             return QoreValue();
         }
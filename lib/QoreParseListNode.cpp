@@ -168,6 +168,7 @@ QoreValue QoreParseListNode::evalImpl(bool& needs_deref, ExceptionSink* xsink) c
     }
     const QoreTypeInfo* ti = qore_get_complex_list_type(vtype);
     ll->complexTypeInfo = ti;
+    ll->pack();
 
     //printd(5, "QoreParseListNode::evalImpl() this: %p size: %zd typeInfo: %p '%s' (vtype: '%s')\n", this, size(),
     //  ti, QoreTypeInfo::getName(ti), QoreTypeInfo::getName(vtype));
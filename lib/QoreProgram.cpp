@@ -173,6 +173,8 @@ ParseOptionMaps::ParseOptionMaps() {
     doMap(PO_NO_INHERIT_PROGRAM_DATA, "PO_NO_INHERIT_PROGRAM_DATA");
     // 61
     doMap(PO_BROKEN_VARARGS, "PO_BROKEN_ELLIPSES");
+    // 62
+    doMap(PO_EXEC_PREDECODED, "PO_EXEC_PREDECODED");
 }
 
 // program serialization magic
@@ -284,6 +286,7 @@ unsigned qore_num_warnings = NUM_WARNINGS;
 qore_program_private::qore_program_to_object_map_t qore_program_private::qore_program_to_object_map;
 QoreRWLock qore_program_private::lck_programMap;
 volatile unsigned qore_program_private::programIdCounter = 1;
+std::atomic<bool> qore_debug_attached = {false};
 
 qore_program_private::qore_program_private(QoreProgram* n_pgm, int64 n_parse_options, QoreProgram* p_pgm)
         : qore_program_private_base(n_pgm, n_parse_options, p_pgm) {
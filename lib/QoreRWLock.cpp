@@ -70,3 +70,8 @@ void QoreVarRWLock::rdlock() {
 int QoreVarRWLock::tryrdlock() {
    return priv->tryrdlock();
 }
+
+//! returns the write sequence counter for optimistic lock-free reads
+unsigned QoreVarRWLock::getWriteSeq() const {
+   return priv->getWriteSeq();
+}
@@ -548,7 +548,15 @@ const QoreOffsetZoneInfo* QoreTimeZoneManager::findCreateOffsetZone(const char*
     }
 
     // now search custom zones
-    QoreAutoRWWriteLocker al(rwl_offset);
+    {
+        QoreAutoDistributedRWReadLocker al(rwl_offset);
+        i = tzomap.find(secs);
+        if (i != tzomap.end()) {
+            return i->second;
+        }
+    }
+
+    QoreAutoDistributedRWWriteLocker al(rwl_offset);
     i = tzomap.find(secs);
     if (i != tzomap.end()) {
         return i->second;
@@ -567,7 +575,15 @@ const QoreOffsetZoneInfo* QoreTimeZoneManager::findCreateOffsetZone(int seconds_
         return nullptr;
     }
 
-    QoreAutoRWWriteLocker al(rwl_offset);
+    {
+        QoreAutoDistributedRWReadLocker al(rwl_offset);
+        tzomap_t::iterator i = tzomap.find(seconds_east);
+        if (i != tzomap.end()) {
+            return i->second;
+        }
+    }
+
+    QoreAutoDistributedRWWriteLocker al(rwl_offset);
     tzomap_t::iterator i = tzomap.find(seconds_east);
     if (i != tzomap.end()) {
         return i->second;
@@ -1596,13 +1612,22 @@ int QoreTimeZoneManager::readAll(ExceptionSink* xsink) {
 }
 
 const AbstractQoreZoneInfo* QoreTimeZoneManager::findLoadRegion(const char* name, ExceptionSink* xsink) {
-    QoreAutoRWWriteLocker al(rwl);
+    // zones that are already loaded only need the read lock
+    const AbstractQoreZoneInfo* rv = getZone(name);
+    if (rv) {
+        return rv;
+    }
+    QoreAutoDistributedRWWriteLocker al(rwl);
     // find or load region
     return processFile(name, false, xsink);
 }
 
 const AbstractQoreZoneInfo* QoreTimeZoneManager::findLoadRegionFromPath(const char* name, ExceptionSink* xsink) {
-    QoreAutoRWWriteLocker al(rwl);
+    const AbstractQoreZoneInfo* rv = getZone(name);
+    if (rv) {
+        return rv;
+    }
+    QoreAutoDistributedRWWriteLocker al(rwl);
     // find or load region
     return processFile(name, true, xsink);
 }
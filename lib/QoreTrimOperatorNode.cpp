@@ -84,7 +84,7 @@ QoreValue QoreTrimOperatorNode::evalImpl(bool& needs_deref, ExceptionSink* xsink
         HashIterator hi(vh);
         while (hi.next()) {
             if (hi.get().getType() == NT_STRING) {
-                QoreValue& v = (*qhi_priv::get(hi)->i)->val;
+                QoreValue& v = qhi_priv::get(hi)->m->val;
                 ensure_unique(v, xsink);
                 QoreStringNode* vs = v.get<QoreStringNode>();
                 if (vs->trim(xsink)) {
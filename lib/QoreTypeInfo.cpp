@@ -38,6 +38,7 @@
 #include "qore/intern/typed_hash_decl_private.h"
 #include "qore/intern/qore_list_private.h"
 #include "qore/intern/QoreHashNodeIntern.h"
+#include "qore/intern/QoreDistributedRWLock.h"
 
 const QoreAnyTypeInfo staticAnyTypeInfo;
 const QoreAutoTypeInfo staticAutoTypeInfo;
@@ -258,7 +259,7 @@ tmap_t ch_map,          // complex hash map
    cslon_map;           // complex softlist or nothing map
 
 // rwlock for global type map
-static QoreRWLock extern_type_info_map_lock;
+static QoreDistributedRWLock extern_type_info_map_lock;
 
 static void do_maps(qore_type_t t, const char* name, const QoreTypeInfo* typeInfo, const QoreTypeInfo* orNothingTypeInfo) {
    str_typeinfo_map[name]                     = typeInfo;
@@ -356,7 +357,7 @@ void delete_qore_types() {
 }
 
 void add_to_type_map(qore_type_t t, const QoreTypeInfo* typeInfo) {
-   QoreAutoRWWriteLocker al(extern_type_info_map_lock);
+   QoreAutoDistributedRWWriteLocker al(extern_type_info_map_lock);
    assert(extern_type_info_map.find(t) == extern_type_info_map.end());
    extern_type_info_map[t] = typeInfo;
 }
@@ -626,7 +627,7 @@ const QoreTypeInfo* qore_get_complex_reference_or_nothing_type(const QoreTypeInf
 }
 
 static const QoreTypeInfo* getExternalTypeInfoForType(qore_type_t t) {
-    QoreAutoRWReadLocker al(extern_type_info_map_lock);
+    QoreAutoDistributedRWReadLocker al(extern_type_info_map_lock);
     type_typeinfo_map_t::iterator i = extern_type_info_map.find(t);
     return (i == extern_type_info_map.end() ? nullptr : i->second);
 }
@@ -1197,7 +1198,7 @@ bool QoreTypeSpec::acceptInputComplexHash(ExceptionSink* xsink, const QoreTypeIn
     // now we have to fold the value types into our type
     HashIterator i(h);
     while (i.next()) {
-        hash_assignment_priv ha(*qore_hash_private::get(*h), *qhi_priv::get(i)->i);
+        hash_assignment_priv ha(*qore_hash_private::get(*h), qhi_priv::get(i)->m);
         QoreValue hn(ha.swap(QoreValue()));
         u.ti->acceptInputIntern(xsink, arg_type, obj, param_num, param_name, hn, lvhelper);
         ha.swap(hn);
@@ -1328,7 +1329,7 @@ bool QoreTypeSpec::acceptInput(ExceptionSink* xsink, const QoreTypeInfo& typeInf
                 // now we have to fold the value types into our type
                 HashIterator i(h);
                 while (i.next()) {
-                    hash_assignment_priv ha(*qore_hash_private::get(*h), *qhi_priv::get(i)->i);
+                    hash_assignment_priv ha(*qore_hash_private::get(*h), qhi_priv::get(i)->m);
                     QoreValue hn(ha.swap(QoreValue()));
                     u.ti->acceptInputIntern(xsink, arg_type, obj, param_num, param_name, hn, lvhelper);
                     ha.swap(hn);
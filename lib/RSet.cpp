@@ -32,8 +32,14 @@
 #include <qore/Qore.h>
 #include "qore/intern/QoreObjectIntern.h"
 
+// time slice for the background collector in microseconds
+#define QORE_RSET_COLLECTOR_SLICE_US 10000
+// pause between background collector time slices in microseconds
+#define QORE_RSET_COLLECTOR_PAUSE_US 1000
+
 RObject::~RObject() {
    assert(!rset);
+   delete rcond;
 }
 
 bool RObject::scanCheck(RSetHelper& rsh, AbstractQoreNode* n) {
@@ -68,7 +74,7 @@ void RObject::derefRealIntern() {
     // before allowing the real references to reach zero, we need to ensure that any rset invalidation action has completed
     while (rrefs == 1 && rref_wait) {
         ++rref_waiting;
-        rcond.wait(rlck);
+        rcondWait();
         --rref_waiting;
     }
     assert(rrefs > 0);
@@ -110,13 +116,13 @@ void RObject::derefDone(bool del) {
     // decrement the in progress count, if it's the last thread, and there are waiting threads, then wake one up
     if ((!--ref_inprogress) && ref_waiting) {
         // we have to use broadcast here because the condition variable is shared
-        rcond.broadcast();
+        rcondBroadcast();
         assert(!del);
     } else if (del) {
         // if we are going to delete the object, then wait for all other in-progress calls to complete first
         while (ref_inprogress) {
             ++ref_waiting;
-            rcond.wait(rlck);
+            rcondWait();
             --ref_waiting;
         }
     }
@@ -151,7 +157,7 @@ int RObject::checkDeferScan() {
     AutoLocker al(rlck);
     rref_wait = false;
     if (rref_waiting)
-        rcond.broadcast();
+        rcondBroadcast();
 
     return -1;
 }
@@ -687,7 +693,7 @@ public:
       AutoLocker al(obj.rlck);
       while (obj.rscan) {
          ++obj.rwaiting;
-         obj.rcond.wait(obj.rlck);
+         obj.rcondWait();
          --obj.rwaiting;
       }
       obj.rscan = q_gettid();
@@ -698,7 +704,7 @@ public:
       assert(obj.rscan == q_gettid());
       // we have to use broadcast here because the condition variable is shared
       if (obj.rwaiting)
-         obj.rcond.broadcast();
+         obj.rcondBroadcast();
       obj.rscan = 0;
    }
 
@@ -707,6 +713,24 @@ public:
    }
 };
 
+// records statistics for a recursive reference scan; statistics are only collected with background collection
+class RScanStatHelper {
+public:
+   DLLLOCAL RScanStatHelper(RSetHelper& rsh) : rsh(rsh), start(q_background_gc ? q_clock_getmicros() : -1) {
+   }
+
+   DLLLOCAL ~RScanStatHelper() {
+      if (start < 0)
+         return;
+      int64 us = q_clock_getmicros() - start;
+      qore_rset_collector.recordScan(rsh.size(), us < 0 ? 0 : us);
+   }
+
+private:
+   RSetHelper& rsh;
+   int64 start;
+};
+
 RSetHelper::RSetHelper(RObject& obj) {
 #ifdef DEBUG
    lcnt = 0;
@@ -720,6 +744,7 @@ RSetHelper::RSetHelper(RObject& obj) {
 
    printd(QRO_LVL, "RSetHelper::RSetHelper() this: %p (%p %s) ENTER\n", this, &obj, obj.getName());
 
+   RScanStatHelper rssh(*this);
    RScanHelper rsh(obj);
 
    while (true) {
@@ -836,3 +861,158 @@ void RSetHelper::rollback() {
    sched_yield();
 #endif
 }
+
+void RSetHelper::scan(RObject& obj) {
+   if (q_background_gc && !q_disable_gc && obj.queueScan())
+      return;
+
+   RSetHelper rsh(obj);
+}
+
+RSetCollector qore_rset_collector;
+
+bool qore_object_private::queueScan() {
+   if (!qore_rset_collector.queueScan(*this))
+      return false;
+
+   // invalidate any rset immediately; it will be recalculated by the collector
+   removeInvalidateRSet();
+   return true;
+}
+
+bool RSetCollector::queueScan(qore_object_private& obj) {
+   AutoLocker al(m);
+   // scans triggered in the collector thread itself are made immediately
+   if (tid.load(std::memory_order_relaxed) == q_gettid())
+      return false;
+
+   if (obj.scan_queued)
+      return true;
+
+   if (!tid.load(std::memory_order_relaxed)) {
+      // no new collector thread can be started once the library is being shut down
+      if (shutting_down)
+         return false;
+      ExceptionSink xsink;
+      int rc = q_start_thread(&xsink, runThread, this);
+      if (rc == -1) {
+         // make the scan in the calling thread if the collector thread cannot be started
+         xsink.clear();
+         return false;
+      }
+      tid.store(rc, std::memory_order_relaxed);
+   }
+
+   // the queue holds a reference to the object until the scan has been made
+   obj.obj->ref();
+   obj.scan_queued = true;
+   queue.push_back(&obj);
+   return true;
+}
+
+void RSetCollector::recordScan(unsigned visited, int64 us) {
+   scans.fetch_add(1, std::memory_order_relaxed);
+   objects_visited.fetch_add(visited, std::memory_order_relaxed);
+   if (tid.load(std::memory_order_relaxed) == q_gettid())
+      background_scans.fetch_add(1, std::memory_order_relaxed);
+
+   // buckets: < 10us, < 100us, < 1ms, < 10ms, < 100ms, >= 100ms
+   unsigned i = 0;
+   for (int64 limit = 10; i < (QORE_RSET_SCAN_TIME_BUCKETS - 1) && us >= limit; ++i, limit *= 10) {
+   }
+   scan_times[i].fetch_add(1, std::memory_order_relaxed);
+}
+
+void RSetCollector::getStatistics(QoreHashNode& h, ExceptionSink* xsink) {
+   static const char* bucket_names[QORE_RSET_SCAN_TIME_BUCKETS] = {
+      "lt_10us", "lt_100us", "lt_1ms", "lt_10ms", "lt_100ms", "ge_100ms",
+   };
+
+   h.setKeyValue("gc_scans", scans.load(std::memory_order_relaxed), xsink);
+   h.setKeyValue("gc_background_scans", background_scans.load(std::memory_order_relaxed), xsink);
+   h.setKeyValue("gc_objects_visited", objects_visited.load(std::memory_order_relaxed), xsink);
+
+   size_t queued;
+   {
+      AutoLocker al(m);
+      queued = queue.size();
+   }
+   h.setKeyValue("gc_queued", (int64)queued, xsink);
+
+   ReferenceHolder<QoreHashNode> th(new QoreHashNode(bigIntTypeInfo), xsink);
+   for (unsigned i = 0; i < QORE_RSET_SCAN_TIME_BUCKETS; ++i) {
+      th->setKeyValue(bucket_names[i], scan_times[i].load(std::memory_order_relaxed), xsink);
+   }
+   h.setKeyValue("gc_scan_times", th.release(), xsink);
+}
+
+void RSetCollector::shutdown() {
+   pthread_t t;
+   {
+      AutoLocker al(m);
+      shutting_down = true;
+      while (tid.load(std::memory_order_relaxed))
+         cond.wait(m);
+      assert(queue.empty());
+      if (!joinable)
+         return;
+      joinable = false;
+      t = ptid;
+   }
+   pthread_join(t, nullptr);
+}
+
+void RSetCollector::runThread(ExceptionSink* xsink, void* arg) {
+   reinterpret_cast<RSetCollector*>(arg)->run(xsink);
+}
+
+void RSetCollector::run(ExceptionSink* xsink) {
+   // join the previous collector thread, which may still be releasing its thread resources, outside the lock
+   bool join_prev;
+   pthread_t prev;
+   {
+      AutoLocker al(m);
+      join_prev = joinable;
+      prev = ptid;
+      ptid = pthread_self();
+      joinable = true;
+      // do not detach the thread when its TID is released so that it can be joined
+      thread_list.setDetached(tid.load(std::memory_order_relaxed));
+   }
+   if (join_prev)
+      pthread_join(prev, nullptr);
+
+   int64 slice_start = q_clock_getmicros();
+
+   while (true) {
+      qore_object_private* obj;
+      {
+         AutoLocker al(m);
+         if (queue.empty()) {
+            // the thread terminates when there are no more objects to scan
+            tid.store(0, std::memory_order_relaxed);
+            cond.broadcast();
+            return;
+         }
+         obj = queue.front();
+         queue.pop_front();
+         obj->scan_queued = false;
+      }
+
+      {
+         RSetHelper rsh(*obj);
+      }
+
+      // release the queue's reference; if the object only has recursive references, it is collected here
+      obj->obj->deref(xsink);
+      if (*xsink)
+         xsink->handleExceptions();
+
+      // pause after each time slice to reduce contention with other threads
+      int64 now = q_clock_getmicros();
+      if ((now - slice_start) >= QORE_RSET_COLLECTOR_SLICE_US) {
+         qore_usleep(QORE_RSET_COLLECTOR_PAUSE_US);
+         slice_start = q_clock_getmicros();
+      }
+   }
+}
@@ -34,6 +34,7 @@
 
 #include <qore/Qore.h>
 #include "qore/RWLock.h"
+#include "qore/intern/DistributedReaderRWLock.h"
 
 #include <cassert>
 
@@ -46,6 +47,9 @@ RWLock::~RWLock() {
 }
 
 int RWLock::numReaders() {
+    DistributedReaderRWLock* drwl = DistributedReaderRWLock::get(this);
+    if (drwl)
+        return drwl->numReadersIntern();
     return num_readers;
 }
 
@@ -340,6 +344,10 @@ void RWLock::mark_read_lock_intern(int mtid, VLock *nvl) {
 }
 
 int RWLock::readLock(ExceptionSink *xsink, int64 timeout_ms) {
+    DistributedReaderRWLock* drwl = DistributedReaderRWLock::get(this);
+    if (drwl)
+        return drwl->readLockIntern(xsink, timeout_ms);
+
     int mtid = q_gettid();
     VLock *nvl = getVLock();
     SafeLocker sl(&asl_lock);
@@ -398,6 +406,10 @@ void RWLock::release_read_lock_intern(tid_map_t::iterator i) {
 }
 
 int RWLock::readUnlock(ExceptionSink* xsink) {
+    DistributedReaderRWLock* drwl = DistributedReaderRWLock::get(this);
+    if (drwl)
+        return drwl->readUnlockIntern(xsink);
+
     int mtid = q_gettid();
     AutoLocker al(&asl_lock);
     if (tid == mtid) {
@@ -423,6 +435,10 @@ int RWLock::readUnlock(ExceptionSink* xsink) {
 }
 
 int RWLock::tryReadLock() {
+    DistributedReaderRWLock* drwl = DistributedReaderRWLock::get(this);
+    if (drwl)
+        return drwl->tryReadLockIntern();
+
     AutoLocker al(&asl_lock);
     if (tid != Lock_Unlocked)
         return -1;
@@ -431,3 +447,384 @@ int RWLock::tryReadLock() {
 
     return 0;
 }
+
+DistributedReaderRWLock::~DistributedReaderRWLock() {
+#ifdef DEBUG
+    for (auto& s : slots)
+        assert(s.tmap.empty());
+#endif
+}
+
+bool DistributedReaderRWLock::getReaders(vlock_map_t& rvmap) {
+    rvmap.clear();
+    for (auto& s : slots) {
+        AutoLocker al(&s.m);
+        rvmap.insert(s.vmap.begin(), s.vmap.end());
+    }
+    return !rvmap.empty();
+}
+
+bool DistributedReaderRWLock::hasReaders() {
+    for (auto& s : slots) {
+        AutoLocker al(&s.m);
+        if (!s.tmap.empty())
+            return true;
+    }
+    return false;
+}
+
+void DistributedReaderRWLock::mark(reader_slot& s, int mtid, VLock* nvl) {
+    tid_map_t::iterator i = s.tmap.find(mtid);
+    if (i != s.tmap.end()) {
+        ++(i->second);
+        return;
+    }
+    s.tmap[mtid] = 1;
+    s.vmap[mtid] = nvl;
+    // now register that we have grabbed this lock with the thread list
+    nvl->push((AbstractSmartLock*)this);
+    // register the thread resource
+    set_thread_resource((AbstractThreadResource*)this);
+}
+
+int DistributedReaderRWLock::numReadersIntern() {
+    int rc = 0;
+    for (auto& s : slots) {
+        AutoLocker al(&s.m);
+        for (auto& i : s.tmap)
+            rc += i.second;
+    }
+    return rc;
+}
+
+bool DistributedReaderRWLock::readLockOwnerIntern() {
+    int mtid = q_gettid();
+    reader_slot& s = getSlot(mtid);
+    AutoLocker al(&s.m);
+    return s.tmap.find(mtid) != s.tmap.end();
+}
+
+int DistributedReaderRWLock::tryReadLockIntern(int mtid, VLock* nvl) {
+    reader_slot& s = getSlot(mtid);
+    AutoLocker al(&s.m);
+    // the read lock can always be acquired recursively; new readers must wait for writers
+    if (writers.load() && s.tmap.find(mtid) == s.tmap.end())
+        return -1;
+    mark(s, mtid, nvl);
+    return 0;
+}
+
+int DistributedReaderRWLock::grabReadLockIntern(int mtid, VLock* nvl, int64 timeout_ms, ExceptionSink* xsink) {
+    while (writers.load() && tid != Lock_Deleted) {
+        ++readRequests;
+        int rc = tid >= 0
+            ? nvl->waitOn((AbstractSmartLock*)this, &read, vl, xsink, timeout_ms)
+            : self_wait(&read, timeout_ms);
+        --readRequests;
+        if (rc)
+            return -1;
+    }
+
+    if (tid == Lock_Deleted) {
+        xsink->raiseException("LOCK-ERROR", "The %s object has been deleted in another thread", getName());
+        return -1;
+    }
+
+    reader_slot& s = getSlot(mtid);
+    AutoLocker al(&s.m);
+    mark(s, mtid, nvl);
+    return 0;
+}
+
+int DistributedReaderRWLock::releaseReadLock(int mtid, bool all, bool remove_resource) {
+    reader_slot& s = getSlot(mtid);
+    int rc;
+    {
+        AutoLocker al(&s.m);
+        tid_map_t::iterator i = s.tmap.find(mtid);
+        if (i == s.tmap.end())
+            return 0;
+        if (!all && i->second > 1) {
+            --(i->second);
+            return 1;
+        }
+        rc = i->second;
+        vlock_map_t::iterator vi = s.vmap.find(mtid);
+        assert(vi != s.vmap.end());
+        // pop the lock from this thread's lock list
+        vi->second->pop((AbstractSmartLock*)this);
+        s.tmap.erase(i);
+        s.vmap.erase(vi);
+    }
+    if (remove_resource)
+        remove_thread_resource((AbstractThreadResource*)this);
+    return rc;
+}
+
+void DistributedReaderRWLock::writerDone() {
+    assert(writers.load() > 0);
+    if (!--writers && readRequests)
+        read.broadcast();
+}
+
+int DistributedReaderRWLock::readLockIntern(ExceptionSink* xsink, int64 timeout_ms) {
+    int mtid = q_gettid();
+    VLock* nvl = getVLock();
+    // readers only need the asl_lock if a writer holds or is waiting for the lock
+    if (tid != mtid && !tryReadLockIntern(mtid, nvl))
+        return 0;
+
+    SafeLocker sl(&asl_lock);
+
+    if (tid == mtid) {
+        xsink->raiseException("LOCK-ERROR", "TID %d called %s::readLock() while holding the write lock", mtid,
+            getName());
+        return -1;
+    }
+
+    return grabReadLockIntern(mtid, nvl, timeout_ms, xsink);
+}
+
+int DistributedReaderRWLock::readUnlockIntern(ExceptionSink* xsink) {
+    int mtid = q_gettid();
+    if (tid == mtid) {
+        xsink->raiseException("LOCK-ERROR", "TID %d called %s::readUnlock() while holding the write lock", mtid,
+            getName());
+        return -1;
+    }
+
+    if (tid == Lock_Deleted) {
+        xsink->raiseException("LOCK-ERROR", "The %s object has been deleted in another thread", getName());
+        return -1;
+    }
+
+    if (!releaseReadLock(mtid, false, true)) {
+        xsink->raiseException("LOCK-ERROR", "TID %d called %s::readUnlock() while not holding the read lock", mtid,
+            getName());
+        return -1;
+    }
+
+    // wake up writers waiting for the read lock to be released
+    if (writers.load()) {
+        AutoLocker al(&asl_lock);
+        if (waiting)
+            asl_cond.broadcast();
+    }
+    return 0;
+}
+
+int DistributedReaderRWLock::tryReadLockIntern() {
+    int mtid = q_gettid();
+    if (tid == mtid)
+        return -1;
+    return tryReadLockIntern(mtid, getVLock());
+}
+
+int DistributedReaderRWLock::externWaitImpl(int mtid, QoreCondition* cond, ExceptionSink* xsink, int64 timeout_ms) {
+    // make sure this TID owns the lock
+    if (mtid == tid) { // in write lock
+        // insert into cond map
+        cond_map_t::iterator i = cmap.find(cond);
+        if (i == cmap.end()) {
+            i = cmap.insert(std::make_pair(cond, 1)).first;
+        } else {
+            ++(i->second);
+        }
+
+        // save vlock
+        VLock* nvl = vl;
+
+        // release lock
+        release_intern();
+
+        // wait for condition
+        int rc = timeout_ms > 0 ? cond->wait2(&asl_lock, timeout_ms) : cond->wait(&asl_lock);
+
+        // decrement cond count and delete from map if 0
+        if (!--(i->second)) {
+            cmap.erase(i);
+        }
+
+        // reacquire the lock
+        if (grabImpl(mtid, nvl, xsink)) {
+            return -1;
+        }
+
+        grab_intern(mtid, nvl);
+        return rc;
+    }
+
+    if (tid == Lock_Deleted) {
+        xsink->raiseException("LOCK-ERROR", "TID %d trying to wait on %s object, but it has been deleted in " \
+            "another thread", mtid, getName());
+        return -1;
+    }
+
+    VLock* nvl = getVLock();
+    // release lock
+    // issue #2817: handle the case when the read lock is held recursively
+    int read_count = releaseReadLock(mtid, true, true);
+    if (!read_count) {
+        xsink->raiseException("LOCK-ERROR", "TID %d trying to wait on %s object while not holding either the read " \
+            "or write lock", mtid, getName());
+        return -1;
+    }
+
+    // in read lock
+    // insert into cond map
+    cond_map_t::iterator ci = cmap.find(cond);
+    if (ci == cmap.end()) {
+        ci = cmap.insert(std::make_pair(cond, 1)).first;
+    } else {
+        ++(ci->second);
+    }
+
+    // wake up writers waiting for the read lock to be released
+    if (waiting)
+        asl_cond.broadcast();
+
+    // wait for condition
+    int rc = timeout_ms ? cond->wait(&asl_lock, timeout_ms) : cond->wait(&asl_lock);
+
+    // decrement cond count and delete from map if 0
+    if (!--(ci->second)) {
+        cmap.erase(ci);
+    }
+
+    // reacquire the lock
+    if (grabReadLockIntern(mtid, nvl, 0, xsink)) {
+        return -1;
+    }
+    if (read_count > 1) {
+        reader_slot& s = getSlot(mtid);
+        AutoLocker al(&s.m);
+        s.tmap[mtid] = read_count;
+    }
+    return rc;
+}
+
+int DistributedReaderRWLock::grabImpl(int mtid, VLock* nvl, ExceptionSink* xsink, int64 timeout_ms) {
+    // check for errors
+    if (tid == mtid) {
+        xsink->raiseException("LOCK-ERROR", "TID %d tried to grab the write lock twice", tid);
+        return -1;
+    }
+    // new readers block while this thread is waiting for the write lock
+    ++writers;
+    vlock_map_t rvmap;
+    while (tid >= 0 || (tid == Lock_Unlocked && getReaders(rvmap))) {
+        ++waiting;
+        int rc;
+        // if the write lock is grabbed, send vl (only one thread owns the lock)
+        if (tid >= 0)
+            rc = nvl->waitOn((AbstractSmartLock*)this, vl, xsink, timeout_ms);
+        else  // otherwise the read lock is grabbed, so send the readers (many threads own the lock)
+            rc = nvl->waitOn((AbstractSmartLock*)this, rvmap, xsink, timeout_ms);
+        --waiting;
+        if (rc) {
+            writerDone();
+            return -1;
+        }
+    }
+    if (tid == Lock_Deleted) {
+        writerDone();
+        xsink->raiseException("LOCK-ERROR", "The %s object has been deleted in another thread", getName());
+        return -1;
+    }
+    return 0;
+}
+
+void DistributedReaderRWLock::signalAllImpl() {
+    if (waiting)
+        asl_cond.broadcast();
+    if (readRequests)
+        read.broadcast();
+}
+
+void DistributedReaderRWLock::signalImpl() {
+    // the write lock has been released
+    if (waiting)
+        asl_cond.signal();
+    writerDone();
+}
+
+void DistributedReaderRWLock::destructorImpl(ExceptionSink* xsink) {
+    cond_map_t::iterator i = cmap.begin(), e = cmap.end();
+    if (i != e) {
+        xsink->raiseException("RWLOCK-ERROR", "%s object deleted in TID %d while one or more Condition variables " \
+            "were waiting on it", getName(), q_gettid());
+        // wake up all condition variables waiting on this mutex
+        for (; i != e; i++)
+            i->first->broadcast();
+    }
+
+    // block new readers permanently
+    ++writers;
+    bool had_readers = false;
+    // release all read locks, but do not remove from the thread resource list
+    for (auto& s : slots) {
+        AutoLocker al(&s.m);
+        for (auto& vi : s.vmap)
+            vi.second->pop((AbstractSmartLock*)this);
+        if (!s.tmap.empty())
+            had_readers = true;
+        s.vmap.clear();
+        s.tmap.clear();
+    }
+    if (had_readers)
+        asl_cond.broadcast();
+    if (readRequests)
+        read.broadcast();
+}
+
+// internal use only - releases read and write locks
+int DistributedReaderRWLock::releaseImpl() {
+    if (releaseReadLock(q_gettid(), false, false)) {
+        // signal writers if any are waiting
+        if (waiting)
+            asl_cond.broadcast();
+        return -1;
+    }
+    return tid >= 0 ? 0 : -1;
+}
+
+// thread exited holding the lock: remove whatever lock was locked
+int DistributedReaderRWLock::cleanupImpl() {
+    // remove all read locks held by this thread
+    if (releaseReadLock(q_gettid(), true, false)) {
+        // wake up threads waiting on write lock, if any
+        if (waiting)
+            asl_cond.broadcast();
+        return -1;
+    }
+
+    // if it was the write lock
+    if (tid >= 0) {
+        // this thread must own the lock
+        assert(tid == q_gettid());
+        // mark lock as unlocked
+        tid = -1;
+
+        // delete entry from the thread lock list
+        vl->pop(this);
+
+        vl = 0;
+        // wake up sleeping thread(s)
+        signalImpl();
+
+        return -1;
+    }
+
+    return 0;
+}
+
+int DistributedReaderRWLock::tryGrabImpl(int mtid, VLock* nvl) {
+    if (tid != Lock_Unlocked || writers.load())
+        return -1;
+    ++writers;
+    if (hasReaders()) {
+        writerDone();
+        return -1;
+    }
+    return 0;
+}
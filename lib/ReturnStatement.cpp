@@ -34,6 +34,10 @@
 
 int ReturnStatement::execImpl(QoreValue& return_value, ExceptionSink* xsink) {
     //QORE_TRACE("ReturnStatement::execImpl()");
+    return execReturn(exp, return_value, xsink);
+}
+
+int ReturnStatement::execReturn(const QoreValue& exp, QoreValue& return_value, ExceptionSink* xsink) {
     ValueEvalOptimizedRefHolder val(exp, xsink);
     if (!*xsink) {
         return_value = val.takeReferencedValue();
@@ -29,6 +29,63 @@
 */
 
 #include <qore/Qore.h>
+#include "qore/intern/QoreClassIntern.h"
+#include "qore/intern/QoreObjectIntern.h"
+
+const QoreMemberInfo* QoreMemberInfoCache::get(const qore_class_private* cls, const char* mem,
+        const qore_class_private* class_ctx) const {
+    unsigned s = seq.load(std::memory_order_acquire);
+    if (!(s & 1) && epoch.load(std::memory_order_relaxed) == qore_class_epoch.load(std::memory_order_acquire)) {
+        bool found = false;
+        const QoreMemberInfo* rv = nullptr;
+        for (int i = 0; i < QORE_MEMBER_CACHE_SIZE; ++i) {
+            const entry_t& e = entries[i];
+            if (e.cls.load(std::memory_order_relaxed) == cls
+                && e.class_ctx.load(std::memory_order_relaxed) == class_ctx) {
+                rv = e.info.load(std::memory_order_relaxed);
+                found = true;
+                break;
+            }
+        }
+
+        // make sure that the entries were not updated while they were being read
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (found && seq.load(std::memory_order_relaxed) == s) {
+            return rv;
+        }
+    }
+
+    const QoreMemberInfo* info = cls->runtimeGetMemberInfo(mem, class_ctx);
+    add(cls, class_ctx, info);
+    return info;
+}
+
+void QoreMemberInfoCache::add(const qore_class_private* cls, const qore_class_private* class_ctx,
+        const QoreMemberInfo* info) const {
+    unsigned s = seq.load(std::memory_order_relaxed);
+    // skip the update if another thread is updating the cache
+    if ((s & 1) || !seq.compare_exchange_strong(s, s + 1, std::memory_order_acquire)) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    unsigned current_epoch = qore_class_epoch.load(std::memory_order_acquire);
+    if (epoch.load(std::memory_order_relaxed) != current_epoch) {
+        for (int i = 0; i < QORE_MEMBER_CACHE_SIZE; ++i) {
+            entries[i].cls.store(nullptr, std::memory_order_relaxed);
+        }
+        next = 0;
+        epoch.store(current_epoch, std::memory_order_relaxed);
+    }
+
+    entry_t& e = entries[next];
+    e.cls.store(cls, std::memory_order_relaxed);
+    e.class_ctx.store(class_ctx, std::memory_order_relaxed);
+    e.info.store(info, std::memory_order_relaxed);
+    next = (next + 1) % QORE_MEMBER_CACHE_SIZE;
+
+    seq.store(s + 2, std::memory_order_release);
+}
 
 // get string representation (for %n and %N), foff is for multi-line formatting offset, -1 = no line breaks
 // the ExceptionSink is only needed for QoreObject where a method may be executed
@@ -56,7 +113,8 @@ QoreValue SelfVarrefNode::evalImpl(bool& needs_deref, ExceptionSink* xsink) cons
     assert(runtime_get_stack_object());
     assert(needs_deref);
     // issue 3523: evaluate in case the value is a reference
-    ValueHolder val(runtime_get_stack_object()->getReferencedMemberNoMethod(str, xsink), xsink);
+    ValueHolder val(qore_object_private::get(*runtime_get_stack_object())->getReferencedMemberNoMethod(str, xsink,
+        &member_cache), xsink);
     // the value here must always require a dereference
     return val->needsEval() ? val->eval(xsink) : val.release();
 }
@@ -31,6 +31,7 @@
 #include <qore/Qore.h>
 #include "qore/intern/StatementBlock.h"
 #include "qore/intern/OnBlockExitStatement.h"
+#include "qore/intern/ReturnStatement.h"
 #include "qore/intern/ParserSupport.h"
 #include "qore/intern/QoreClassIntern.h"
 #include "qore/intern/qore_program_private.h"
@@ -147,6 +148,10 @@ StatementBlock::StatementBlock(int sline, int eline, AbstractStatement* s) : Abs
 QoreValue StatementBlock::exec(ExceptionSink* xsink) {
     //QORE_TRACE("StatementBlock::exec()");
     QoreValue return_value;
+    if (!qore_debug_attached.load(std::memory_order_acquire)) {
+        execImpl(return_value, xsink);
+        return return_value;
+    }
     ThreadLocalProgramData* tlpd = get_thread_local_program_data();
     if (tlpd->runtimeCheck()) {
         tlpd->dbgFunctionEnter(this, xsink);
@@ -175,6 +180,8 @@ void StatementBlock::del() {
         delete *i;
 
     statement_list.clear();
+    exec_list.clear();
+    exec_code.clear();
 
     if (lvars) {
         delete lvars;
@@ -190,6 +197,67 @@ int StatementBlock::execImpl(QoreValue& return_value, ExceptionSink* xsink) {
     return execIntern(return_value, xsink);
 }
 
+// executes the statements in the list; debugger checks are only made if "debug" is true
+template <bool debug, typename T>
+static int exec_statements(const T& list, const StatementBlock* block, ThreadLocalProgramData* tlpd,
+        QoreValue& return_value, ExceptionSink* xsink) {
+    int rc = 0;
+    for (auto i : list) {
+        if (debug && tlpd->runtimeCheck()) {
+            rc = tlpd->dbgStep(block, i, xsink);
+            if (rc || *xsink) {
+                break;
+            }
+        }
+        rc = i->exec(return_value, xsink);
+        if (debug && *xsink && tlpd->runtimeCheck()) {
+            tlpd->dbgException(i, xsink);
+            if (*xsink) {
+                break;
+            }
+        }
+        if (rc) {
+            break;
+        }
+    }
+    return rc;
+}
+
+// executes the pre-decoded statements; expression and return statements are evaluated directly in the dispatch loop
+// without a virtual call or saving and restoring the current statement, and the stack is checked once for the block
+int StatementBlock::execPredecoded(QoreValue& return_value, ExceptionSink* xsink) {
+    QoreProgramBlockStatementHelper stmt_helper(xsink, this);
+    if (*xsink) {
+        return 0;
+    }
+    for (const exec_op_t& i : exec_code) {
+        switch (i.op) {
+            case QSOP_EXPRESSION: {
+                stmt_helper.set(i.stmt);
+                ValueEvalOptimizedRefHolder erh(i.exp, xsink);
+                break;
+            }
+
+            case QSOP_RETURN:
+                stmt_helper.set(i.stmt);
+                return ReturnStatement::execReturn(i.exp, return_value, xsink);
+
+            default: {
+                int rc = i.stmt->exec(return_value, xsink);
+                if (rc) {
+                    return rc;
+                }
+                break;
+            }
+        }
+        // no further statements are executed once an exception has been raised
+        if (*xsink) {
+            break;
+        }
+    }
+    return 0;
+}
+
 int StatementBlock::execIntern(QoreValue& return_value, ExceptionSink* xsink) {
     //QORE_TRACE("StatementBlock::execIntern()");
     int rc = 0;
@@ -204,28 +272,27 @@ int StatementBlock::execIntern(QoreValue& return_value, ExceptionSink* xsink) {
         pushBlock(on_block_exit_list.end());
     }
 
-    ThreadLocalProgramData* tlpd = get_thread_local_program_data();
-    // to execute even when block is empty, e.g. while(true);
-    if (tlpd->runtimeCheck()) {
-        rc = tlpd->dbgStep(this, nullptr, xsink);
-    }
-    if (!rc && !*xsink) {
-        // execute block
-        for (auto i : statement_list) {
-            if (tlpd->runtimeCheck()) {
-                rc = tlpd->dbgStep(this, i, xsink);
-                if (rc || *xsink) {
-                    break;
-                }
-            }
-            rc = i->exec(return_value, xsink);
-            if (*xsink && tlpd->runtimeCheck()) {
-                tlpd->dbgException(i, xsink);
-                if (*xsink) {
-                    break;
-                }
-            }
-            if (rc) break;
+    // debugger checks are only made once a debug program has been attached to a Program
+    if (!qore_debug_attached.load(std::memory_order_acquire)) {
+        // execute block; use the pre-decoded statements or the contiguous statement array if the block has been
+        // committed
+        if (!exec_code.empty()) {
+            rc = execPredecoded(return_value, xsink);
+        } else {
+            rc = exec_list.empty()
+                ? exec_statements<false>(statement_list, this, nullptr, return_value, xsink)
+                : exec_statements<false>(exec_list, this, nullptr, return_value, xsink);
+        }
+    } else {
+        ThreadLocalProgramData* tlpd = get_thread_local_program_data();
+        // to execute even when block is empty, e.g. while(true);
+        if (tlpd->runtimeCheck()) {
+            rc = tlpd->dbgStep(this, nullptr, xsink);
+        }
+        if (!rc && !*xsink) {
+            rc = exec_list.empty()
+                ? exec_statements<true>(statement_list, this, tlpd, return_value, xsink)
+                : exec_statements<true>(exec_list, this, tlpd, return_value, xsink);
         }
     }
     // execute "on block exit" code if applicable
@@ -300,6 +367,9 @@ LocalVar* push_local_var(const char* name, const QoreProgramLocation* loc,
     }
 
     LocalVar* lv = qore_program_private::get(*pgm)->createLocalVar(name, typeInfo);
+    if (!is_auto && parse_check_parse_option(PO_STRICT_TYPES)) {
+        lv->setStrictInit();
+    }
 
     /*
     QoreString ls;
@@ -435,9 +505,22 @@ int StatementBlock::parseInitIntern(QoreParseContext& parse_context, statement_l
 void StatementBlock::parseCommit(QoreProgram* pgm) {
     // add block to the list only when no statements inside
     qore_program_private::registerStatement(pgm, this, statement_list.empty());
+    exec_list.clear();
+    exec_list.reserve(statement_list.size());
     for (statement_list_t::iterator i = statement_list.begin(), e = statement_list.end(); i != e; ++i) {
         // register and add statements
         (*i)->parseCommit(pgm);
+        exec_list.push_back(*i);
+    }
+
+    exec_code.clear();
+    if (pwo.parse_options & PO_EXEC_PREDECODED) {
+        exec_code.reserve(exec_list.size());
+        for (AbstractStatement* i : exec_list) {
+            QoreValue exp;
+            qore_stmt_op_e op = i->getExecOp(exp);
+            exec_code.push_back({i, exp, op});
+        }
     }
 }
 
@@ -32,6 +32,18 @@
 #include "qore/intern/TryStatement.h"
 #include "qore/intern/StatementBlock.h"
 
+// returns true for exception information members that can be read without the call stack
+static bool exception_member_without_callstack(const char* member) {
+    static const char* members[] = {"err", "desc", "arg", "type", "file", "line", "endline", "source", "offset",
+        "lang",};
+    for (const char* m : members) {
+        if (!strcmp(member, m)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 TryStatement::TryStatement(const QoreProgramLocation* loc, StatementBlock* t, StatementBlock* c, char* p,
         const QoreTypeInfo* typeInfo, QoreParseTypeInfo* parseTypeInfo, const QoreProgramLocation* vloc)
         : AbstractStatement(loc), try_block(t), catch_block(c), param(p), typeInfo(typeInfo),
@@ -63,7 +75,7 @@ int TryStatement::execImpl(QoreValue& return_value, ExceptionSink *xsink) {
 
             // instantiate exception information parameter
             if (param)
-                id->instantiate(except->makeExceptionObject());
+                id->instantiate(except->makeExceptionObject(0, needs_callstack));
 
             rc = catch_block->execImpl(*trv, xsink);
 
@@ -116,6 +128,9 @@ int TryStatement::parseInitImpl(QoreParseContext& parse_context) {
         // in case the variable is not actually referenced in the catch block
         id = push_local_var(param, loc, typeInfo, err, true, 1);
         printd(3, "TryStatement::parseInitImpl() reg. local var %s (id=%p)\n", param, id);
+        // the call stack is only created if the exception hash can be accessed other than by reading members
+        // without the call stack
+        id->parseTrackMemberReads(exception_member_without_callstack);
     } else {
         id = nullptr;
         assert(!parseTypeInfo);
@@ -135,6 +150,7 @@ int TryStatement::parseInitImpl(QoreParseContext& parse_context) {
 
     // pop local param from stack
     if (param) {
+        needs_callstack = !id->parseOnlyFilteredMemberReads();
         pop_local_var();
     }
 
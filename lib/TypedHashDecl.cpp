@@ -105,6 +105,32 @@ typed_hash_decl_private::typed_hash_decl_private(const typed_hash_decl_private&
     }
 }
 
+typed_hash_decl_private::~typed_hash_decl_private() {
+    delete typeInfo;
+    delete orNothingTypeInfo;
+    delete shape.load(std::memory_order_relaxed);
+}
+
+const QoreHashShape* typed_hash_decl_private::getShape() const {
+    const QoreHashShape* rv = shape.load(std::memory_order_acquire);
+    if (rv) {
+        return rv;
+    }
+
+    std::vector<const QoreHashKey*> keys;
+    keys.reserve(members.member_list.size());
+    for (auto& i : members.member_list) {
+        keys.push_back(QoreHashKey::get(i.first));
+    }
+    QoreHashShape* s = new QoreHashShape(std::move(keys));
+    // another thread may have created the shape in the meantime
+    if (!shape.compare_exchange_strong(rv, s, std::memory_order_acq_rel)) {
+        delete s;
+        return rv;
+    }
+    return s;
+}
+
 int typed_hash_decl_private::parseInitHashDeclInitialization(const QoreProgramLocation* loc,
         QoreParseContext& parse_context, QoreParseListNode* args, bool& runtime_check) const {
     runtime_check = false;
@@ -372,20 +398,27 @@ int typed_hash_decl_private::initHashIntern(QoreHashNode* h, const QoreHashNode*
     }
 #endif
 
-    for (auto& i : members.member_list) {
+    // members are created with the interned keys of the hashdecl's key layout
+    const QoreHashShape* hs = getShape();
+    assert(hs->size() == members.member_list.size());
+    qore_hash_private* h_priv = qore_hash_private::get(*h);
+    h_priv->member_list.reserve(h_priv->member_list.size() + hs->size());
+
+    for (size_t idx = 0, e = members.member_list.size(); idx < e; ++idx) {
+        auto& i = members.member_list[idx];
+        const QoreHashKey& key = hs->getKey(idx);
         // first try to use value given in init hash
         if (init) {
             const qore_hash_private* hi = qore_hash_private::get(*init);
             bool exists;
-            ValueHolder val(hi->getReferencedKeyValueIntern(i.first, exists), xsink);
+            ValueHolder val(hi->getReferencedKeyValueIntern(key, exists), xsink);
             if (exists) {
                 // check types
                 QoreTypeInfo::acceptInputKey(i.second->getTypeInfo(), i.first, *val, xsink);
                 if (*xsink) {
                     return -1;
                 }
-                qore_hash_private* h_priv = qore_hash_private::get(*h);
-                QoreValue& v = h_priv->getValueRef(i.first);
+                QoreValue& v = h_priv->getValueRef(key);
                 assert(v.isNothing());
                 v = val.release();
                 // issue #3481: maintain DGC counts
@@ -401,8 +434,7 @@ int typed_hash_decl_private::initHashIntern(QoreHashNode* h, const QoreHashNode*
         }
 
         if (i.second->exp) {
-            qore_hash_private* h_priv = qore_hash_private::get(*h);
-            QoreValue& v = h_priv->getValueRef(i.first);
+            QoreValue& v = h_priv->getValueRef(key);
             assert(v.isNothing());
 
             ValueEvalOptimizedRefHolder val(i.second->exp, xsink);
@@ -434,8 +466,7 @@ int typed_hash_decl_private::initHashIntern(QoreHashNode* h, const QoreHashNode*
                         "%s value for key '%s'", name.c_str(), QoreTypeInfo::getName(key_type), i.first);
                     return -1;
                 }
-                qore_hash_private* h_priv = qore_hash_private::get(*h);
-                QoreValue& v = h_priv->getValueRef(i.first);
+                QoreValue& v = h_priv->getValueRef(key);
                 assert(v.isNothing());
                 v = QoreTypeInfo::getDefaultQoreValue(i.second->getTypeInfo());
                 // issue #3481: maintain DGC counts
@@ -108,6 +108,7 @@ void VarRefNode::resolve(const QoreTypeInfo* typeInfo) {
             parse_error(*loc, "type definition given for existing local variable '%s'", id->getName());
 
         ref.id = id;
+        id->parseRef();
         if (in_closure)
             setClosureIntern();
         else
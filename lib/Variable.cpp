@@ -248,6 +248,11 @@ QoreValue Var::eval() const {
         }
         return val.getReferencedValue();
     }
+    {
+        QoreValue rv;
+        if (tryOptimisticEval(rv))
+            return rv;
+    }
     QoreAutoVarRWReadLocker al(rwl);
     switch (val.getType()) {
         case NT_WEAKREF:
@@ -260,6 +265,34 @@ QoreValue Var::eval() const {
     return val.getReferencedValue();
 }
 
+bool Var::tryOptimisticEval(QoreValue& rv) const {
+    // scalar values (and NOTHING) are read without the lock and validated with the write sequence counter;
+    // node values are reference-counted and could be freed by a concurrent writer before they are referenced,
+    // so they are always read with the read lock held
+    unsigned seq = rwl.getWriteSeq();
+    if (seq & 1)
+        return false;
+    QoreLValue<qore_gvar_ref_u>& val = getVal();
+    if (!val.assigned) {
+        rv = QoreValue();
+    } else {
+        switch (val.type) {
+            case QV_Bool: rv = QoreValue(val.v.b); break;
+            case QV_Int: rv = QoreValue(val.v.i); break;
+            case QV_Float: rv = QoreValue(val.v.f); break;
+            case QV_Node:
+                if (val.v.n)
+                    return false;
+                rv = QoreValue();
+                break;
+            default:
+                return false;
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return rwl.getWriteSeq() == seq;
+}
+
 void Var::deref(ExceptionSink* xsink) {
     //printd(5, "Var::deref() this: %p '%s' %d -> %d\n", this, getName(), reference_count(), reference_count() - 1);
     if (ROdereference()) {
@@ -321,6 +354,8 @@ LValueHelper::~LValueHelper() {
     // references before, then we don't need to scan this time either
     bool obj_chg = before;
     bool obj_ref = false;
+    // set if an object of a cycle-free class was assigned to an object member, which would otherwise require a scan
+    bool scan_avoided = false;
 
     if (!(*vl.xsink) && (val || qv)) {
         // see if we have any object count changes
@@ -362,8 +397,12 @@ LValueHelper::~LValueHelper() {
             }
         }
 
-        if (!obj_chg && (val ? val->needsScan() : needs_scan(*qv))) {
-            obj_chg = true;
+        if (!obj_chg) {
+            if (val ? val->needsScan() : needs_scan(*qv)) {
+                obj_chg = true;
+            } else if (robj && is_cycle_free_object(val ? val->getInternalNode() : qv->getInternalNode())) {
+                scan_avoided = true;
+            }
         }
         if (robj) {
             robj->tRef();
@@ -387,7 +426,9 @@ LValueHelper::~LValueHelper() {
     if (robj) {
         // recalculate recursive references for objects if necessary
         if (obj_chg) {
-            RSetHelper rsh(*robj);
+            RSetHelper::scan(*robj);
+        } else if (scan_avoided) {
+            q_inc_thread_stat(QSTAT_OBJECT_SCANS_AVOIDED);
         }
         if (obj_ref) {
             robj->tDeref();
@@ -506,7 +547,7 @@ int LValueHelper::doListLValue(const QoreSquareBracketsOperatorNode* op, bool fo
     return qore_list_private::get(*l)->getLValue((size_t)ind, *this, for_remove, vl.xsink);
 }
 
-int LValueHelper::doHashLValue(qore_type_t t, const char* mem, bool for_remove) {
+int LValueHelper::doHashLValue(qore_type_t t, const char* mem, bool for_remove, const QoreHashKey* key) {
     QoreHashNode* h;
     if (t == NT_HASH) {
         ensureUnique();
@@ -583,7 +624,9 @@ int LValueHelper::doHashLValue(qore_type_t t, const char* mem, bool for_remove)
 
     //printd(5, "LValueHelper::doHashLValue() def: %s member %s \"%s\"\n", QCS_DEFAULT->getCode(),
     //    mem->getEncoding()->getCode(), mem->getBuffer());
-    return qore_hash_private::get(*h)->getLValue(mem, *this, for_remove, vl.xsink);
+    return key
+        ? qore_hash_private::get(*h)->getLValue(*key, *this, for_remove, vl.xsink)
+        : qore_hash_private::get(*h)->getLValue(mem, *this, for_remove, vl.xsink);
 }
 
 int LValueHelper::doObjLValue(QoreObject* o, const char* mem, bool for_remove) {
@@ -613,6 +656,12 @@ int LValueHelper::doObjLValue(QoreObject* o, const char* mem, bool for_remove) {
 }
 
 int LValueHelper::doHashObjLValue(const QoreHashObjectDereferenceOperatorNode* op, bool for_remove) {
+    // string literal keys are resolved when parsing
+    const QoreHashKey* key = op->getInternedKey();
+    if (key) {
+        return doHashObjLValue(op->getLeft(), key->c_str(), key, for_remove);
+    }
+
     ValueEvalOptimizedRefHolder rh(op->getRight(), vl.xsink);
     if (*vl.xsink) {
         return -1;
@@ -624,7 +673,11 @@ int LValueHelper::doHashObjLValue(const QoreHashObjectDereferenceOperatorNode* o
         return -1;
     }
 
-    if (doLValue(op->getLeft(), for_remove)) {
+    return doHashObjLValue(op->getLeft(), mem->c_str(), nullptr, for_remove);
+}
+
+int LValueHelper::doHashObjLValue(const QoreValue& left, const char* mem, const QoreHashKey* key, bool for_remove) {
+    if (doLValue(left, for_remove)) {
         return -1;
     }
 
@@ -635,10 +688,10 @@ int LValueHelper::doHashObjLValue(const QoreHashObjectDereferenceOperatorNode* o
     } else if (t == NT_OBJECT) {
         o = getValue().get<QoreObject>();
     } else {
-        return doHashLValue(t, mem->c_str(), for_remove);
+        return doHashLValue(t, mem, for_remove, key);
     }
 
-    return doObjLValue(o, mem->c_str(), for_remove);
+    return doObjLValue(o, mem, for_remove);
 }
 
 void LValueHelper::setObjectContext(qore_object_private* obj) {
@@ -688,7 +741,8 @@ int LValueHelper::doLValue(const QoreValue& n, bool for_remove) {
         ocvec.clear();
         clearPtr();
 
-        if (qore_object_private::getLValue(*obj, v->str, *this, runtime_get_class(), for_remove, vl.xsink)) {
+        if (qore_object_private::getLValue(*obj, v->str, *this, runtime_get_class(), for_remove, vl.xsink,
+            v->getMemberCache())) {
             // here the object has already been cleared above
             return -1;
         }
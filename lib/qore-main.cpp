@@ -151,6 +151,14 @@ void qore_init(qore_license_t license, const char* def_charset, bool show_module
         q_disable_gc = true;
     }
 
+    if (qore_library_options & QLO_BACKGROUND_GARBAGE_COLLECTION) {
+        q_background_gc = true;
+    }
+
+    if (qore_library_options & QLO_BACKGROUND_THREAD_POOL) {
+        q_background_thread_pool = true;
+    }
+
     qore_string_init();
     QoreHttpClientObject::static_init();
 
@@ -224,6 +232,9 @@ void qore_cleanup() {
         purge_thread_resources(&xsink);
     }
 
+    // wait for any background recursive reference scans and object collection to complete
+    qore_rset_collector.shutdown();
+
     // first delete all user modules
     QMM.delUser();
 
@@ -261,6 +272,9 @@ void qore_cleanup() {
     // delete default type values
     delete_qore_types();
 
+    // release the interned hash key table; keys still referenced are freed when their last reference is released
+    delete_hash_keys();
+
     // delete threading infrastructure
     delete_qore_threads();
 
@@ -5002,6 +5002,8 @@ void init() {
     fset.insert("RET_VALUE_ONLY");
     fset.insert("RUNTIME_NOOP");
     fset.insert("CONSTANT");
+    fset.insert("PURE_INTERN");
+    fset.insert("PURE");
 }
 
 void usage() {
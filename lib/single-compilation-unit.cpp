@@ -311,6 +311,7 @@
 #include "QC_SingleValueIterator.cpp"
 #include "QC_RangeIterator.cpp"
 #include "QC_ThreadPool.cpp"
+#include "QC_ThreadPoolFuture.cpp"
 #include "QC_AbstractDatasource.cpp"
 #include "QC_AbstractSQLStatement.cpp"
 #include "QC_Datasource.cpp"
@@ -64,6 +64,7 @@
 #include <sys/resource.h>
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <map>
 #include <pthread.h>
@@ -95,6 +96,8 @@ DLLLOCAL QoreRWLock lck_debug_program;
 QoreThreadLock stack_lck;
 // 8MB default thread stack size
 #define STACK_SIZE (8 * 1024 * 1024)
+// maximum number of empty lists kept for reuse by each thread
+#define QORE_THREAD_EVAL_LIST_CACHE 8
 
 // default size and limit for qore threads; to be set in init_qore_threads()
 size_t qore_thread_stack_size = 0;
@@ -106,6 +109,7 @@ QorePThreadAttr ta_default;
 DLLLOCAL QoreThreadList thread_list;
 
 DLLLOCAL QoreClass* initThreadPoolClass(QoreNamespace& ns);
+DLLLOCAL QoreClass* initThreadPoolFutureClass(QoreNamespace& ns);
 
 class ArgvRefStack {
 protected:
@@ -289,7 +293,8 @@ public:
     ProgramParseContext* plStack = nullptr;
     // current runtime stack location
     const QoreStackLocation* current_stack_location = nullptr;
-    // current dynamic runtime location
+    // current dynamic runtime location; if nullptr, then the location is the location of runtime_statement, which is
+    // only resolved when needed so that executing a statement does not need to set the location and parse options
     const QoreProgramLocation* runtime_loc = &loc_builtin;
     // current dynamic runtime statement
     const AbstractStatement* runtime_statement = nullptr;
@@ -412,6 +417,10 @@ public:
     // active exception counter
     unsigned active_exceptions = 0;
 
+    // empty lists that can be reused for evaluation results; see qore_list_private::getEvalList()
+    QoreListNode* eval_list_cache[QORE_THREAD_EVAL_LIST_CACHE];
+    unsigned eval_list_cache_count = 0;
+
     bool
         foreign : 1, // true if the thread is a foreign thread
         try_reexport : 1,
@@ -473,6 +482,19 @@ public:
 #endif // #ifdef QORE_MANAGE_STACK
     }
 
+    // returns the current runtime location
+    DLLLOCAL const QoreProgramLocation* getRuntimeLocation() const {
+        if (runtime_loc) {
+            return runtime_loc;
+        }
+        return runtime_statement ? runtime_statement->loc : nullptr;
+    }
+
+    // returns the current runtime parse options
+    DLLLOCAL int64 getRuntimeParseOptions() const {
+        return runtime_statement ? runtime_statement->pwo.parse_options : runtime_po;
+    }
+
     DLLLOCAL ~ThreadData() {
         // delete all user TLD
         for (auto& i : u_tld_map) {
@@ -486,6 +508,10 @@ public:
         assert(!trlist->prev);
         delete pcs;
         delete trlist;
+
+        for (unsigned i = 0; i < eval_list_cache_count; ++i) {
+            eval_list_cache[i]->deref(nullptr);
+        }
     }
 
     DLLLOCAL void endFileParsing() {
@@ -745,6 +771,75 @@ tid_node::~tid_node() {
     }
 }
 
+int QoreThreadList::get(int status, bool reuse_last) {
+    int tid = -1;
+    AutoLocker al(lck);
+
+    // current_tid is only modified with the lock held
+    int ctid = current_tid.load(std::memory_order_relaxed);
+    if (ctid >= thread_limit) {
+        // reassign released TIDs in round-robin order starting after the last TID issued to avoid reusing the same
+        // TID over and over again; never try to assign TID 0
+        tid = findAvail(last_tid + 1, thread_limit);
+        if (tid == -1 && last_tid) {
+            tid = findAvail(1, last_tid < thread_limit ? last_tid + 1 : thread_limit);
+        }
+        if (tid == -1) {
+            return -1;
+        }
+        clearAvail(tid);
+        last_tid = tid;
+    } else if (reuse_last && ctid && entry(ctid - 1).available()) {
+        printd(5, "QoreThreadList::get() reusing TID %d\n", ctid - 1);
+        // re-assign the last assigned TID
+        tid = ctid - 1;
+        clearAvail(tid);
+    } else {
+        tid = ctid;
+        if (!entry_chunks[tid >> QORE_THREAD_ENTRY_CHUNK_BITS]) {
+            allocateChunk(tid >> QORE_THREAD_ENTRY_CHUNK_BITS);
+        }
+        // publish the new TID only after its chunk has been allocated for lock-free hasEntry() calls
+        current_tid.store(ctid + 1, std::memory_order_release);
+    }
+    assert(entry(tid).available());
+
+    entry(tid).allocate(new tid_node(tid), status);
+    ++num_threads;
+    //printf("t%d cs=0\n", tid);
+
+    return tid;
+}
+
+int QoreThreadList::findAvail(int start, int end) const {
+    if (start >= end) {
+        return -1;
+    }
+    unsigned w = start >> 6;
+    assert(w < avail_bits.size());
+    uint64_t bits = avail_bits[w] & (~0ULL << (start & 63));
+    if (!bits) {
+        // find the next non-empty bitmap word with the summary bitmap
+        ++w;
+        unsigned sw = w >> 6;
+        if (sw >= avail_summary.size()) {
+            return -1;
+        }
+        uint64_t sbits = avail_summary[sw] & (~0ULL << (w & 63));
+        while (!sbits) {
+            if (++sw >= avail_summary.size() || (int)(sw << 12) >= end) {
+                return -1;
+            }
+            sbits = avail_summary[sw];
+        }
+        w = (sw << 6) + __builtin_ctzll(sbits);
+        bits = avail_bits[w];
+        assert(bits);
+    }
+    int tid = (w << 6) + __builtin_ctzll(bits);
+    return tid < end ? tid : -1;
+}
+
 class BGThreadParams {
 private:
     // call_obj: get and reference the current stack object, if any, for the new call stack
@@ -771,7 +866,7 @@ public:
             ThreadData* td = thread_data.get();
             call_obj = td->current_obj;
             class_ctx = td->current_class;
-            loc = td->runtime_loc;
+            loc = td->getRuntimeLocation();
         }
 
         //printd(5, "BGThreadParams::BGThreadParams(f: %p (%s %d), t: %d) this: %p call_obj: %p '%s' cc: %p '%s' "
@@ -881,6 +976,119 @@ public:
     }
 };
 
+// the maximum number of parked threads kept for reuse by the background operator
+#define QORE_BG_THREAD_POOL_MAX 64
+// parked threads exit after waiting this long for a new background expression
+#define QORE_BG_THREAD_IDLE_MS 60000
+
+// number of threads created and reused for the background operator
+std::atomic<int64> qore_bg_threads_created = {0};
+std::atomic<int64> qore_bg_threads_reused = {0};
+
+//! a process-wide pool of parked native threads that can be reused by the background operator
+/** when a background thread finishes, it has already released its TID and deleted its thread data; if the pool is
+    enabled, the thread then parks here instead of exiting and can be handed the next background expression
+*/
+class QoreBackgroundThreadPool {
+public:
+    //! hands a background expression to a parked thread; returns false if no thread is parked
+    DLLLOCAL bool dispatch(BGThreadParams* btp) {
+        AutoLocker al(l);
+        if (parked.empty()) {
+            return false;
+        }
+        parked_thread* pt = parked.back();
+        parked.pop_back();
+        pt->btp = btp;
+        pt->cond.signal();
+        qore_bg_threads_reused.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    //! registers the current thread as waiting to be parked
+    /** must be called before the thread is removed from the thread counter so that shutdown() waits for the thread
+        even if it has not yet called park()
+    */
+    DLLLOCAL void enter() {
+        AutoLocker al(l);
+        ++waiting;
+    }
+
+    //! parks the current thread; returns the next background expression or nullptr if the thread should exit
+    /** must be called after enter(); if nullptr is returned, then exitThread() must be called after the thread's final
+        cleanup
+    */
+    DLLLOCAL BGThreadParams* park() {
+        parked_thread pt;
+        AutoLocker al(l);
+        assert(waiting);
+        if (!q_background_thread_pool || exiting || parked.size() >= QORE_BG_THREAD_POOL_MAX) {
+            return nullptr;
+        }
+        // most recently parked threads are reused first
+        parked.push_back(&pt);
+        while (!pt.btp && !pt.exit) {
+            if (pt.cond.wait(l, QORE_BG_THREAD_IDLE_MS) && !pt.btp && !pt.exit) {
+                // timed out; remove this thread from the pool and exit
+                parked.erase(std::find(parked.begin(), parked.end(), &pt));
+                break;
+            }
+        }
+        if (pt.btp) {
+            --waiting;
+        }
+        return pt.btp;
+    }
+
+    //! called by a thread after park() returned nullptr as the last action before the thread exits
+    DLLLOCAL void exitThread() {
+        AutoLocker al(l);
+        if (!--waiting && exiting) {
+            exit_cond.broadcast();
+        }
+    }
+
+    //! makes all parked threads exit, for example after the default stack size has been changed
+    DLLLOCAL void flush() {
+        AutoLocker al(l);
+        flushIntern();
+    }
+
+    //! makes all parked threads exit and waits for them to finish; no threads are parked afterwards
+    DLLLOCAL void shutdown() {
+        AutoLocker al(l);
+        exiting = true;
+        flushIntern();
+        while (waiting) {
+            exit_cond.wait(l);
+        }
+    }
+
+private:
+    struct parked_thread {
+        QoreCondition cond;
+        BGThreadParams* btp = nullptr;
+        bool exit = false;
+    };
+
+    QoreThreadLock l;
+    QoreCondition exit_cond;
+    std::vector<parked_thread*> parked;
+    // the number of threads that have called enter() and have not yet been reused or exited
+    unsigned waiting = 0;
+    bool exiting = false;
+
+    DLLLOCAL void flushIntern() {
+        for (parked_thread* pt : parked) {
+            pt->exit = true;
+            pt->cond.signal();
+        }
+        parked.clear();
+    }
+};
+
+static QoreBackgroundThreadPool bg_thread_pool;
+
 ThreadCleanupList::ThreadCleanupList() {
     //printf("ThreadCleanupList::ThreadCleanupList() head=NULL\n");
     head = nullptr;
@@ -1105,10 +1313,10 @@ void thread_uninstantiate_self() {
     td->tlpd->lvstack.uninstantiateSelf();
 }
 
-LocalVarValue* thread_find_lvar(const char* id) {
+LocalVarValue* thread_find_lvar(const char* id, std::atomic<int>& slot) {
     ThreadData* td = thread_data.get();
     //printd(5, "thread_find_lvar() pgm: %p tlpd: %p id: %s\n", td->current_pgm, td->tlpd, id);
-    return td->tlpd->lvstack.find(id);
+    return td->tlpd->lvstack.find(id, slot);
 }
 
 ClosureVarValue* thread_instantiate_closure_var(const char* n_id, const QoreTypeInfo* typeInfo, QoreValue& nval, bool assign) {
@@ -1509,18 +1717,17 @@ const AbstractStatement* get_runtime_statement() {
 }
 
 const QoreProgramLocation* get_runtime_location() {
-    return thread_data.get()->runtime_loc;
+    return thread_data.get()->getRuntimeLocation();
 }
 
-int swap_runtime_statement_location(ExceptionSink* xsink, const AbstractStatement* stmt, const QoreProgramLocation* loc,
-        int64 po, const AbstractStatement*& old_stmt, const QoreProgramLocation*& old_loc, int64& old_po) {
+int swap_runtime_statement(ExceptionSink* xsink, const AbstractStatement* stmt, const AbstractStatement*& old_stmt,
+        const QoreProgramLocation*& old_loc) {
     ThreadData* td = thread_data.get();
     old_stmt = td->runtime_statement;
     old_loc = td->runtime_loc;
-    old_po = td->runtime_po;
+    // the location and parse options are taken from the statement when needed
     td->runtime_statement = stmt;
-    td->runtime_loc = loc;
-    td->runtime_po = po;
+    td->runtime_loc = nullptr;
 
 #ifdef QORE_MANAGE_STACK
     return check_stack_intern(xsink, td);
@@ -1529,11 +1736,33 @@ int swap_runtime_statement_location(ExceptionSink* xsink, const AbstractStatemen
 #endif
 }
 
+ThreadData* swap_runtime_block(ExceptionSink* xsink, const AbstractStatement* block,
+        const AbstractStatement*& old_stmt, const QoreProgramLocation*& old_loc) {
+    ThreadData* td = thread_data.get();
+    old_stmt = td->runtime_statement;
+    old_loc = td->runtime_loc;
+    td->runtime_statement = block;
+    td->runtime_loc = nullptr;
+
+#ifdef QORE_MANAGE_STACK
+    check_stack_intern(xsink, td);
+#endif
+    return td;
+}
+
+void set_runtime_statement(ThreadData* td, const AbstractStatement* stmt) {
+    td->runtime_statement = stmt;
+    td->runtime_loc = nullptr;
+}
+
 void swap_runtime_location(const QoreProgramLocation* loc, const AbstractStatement*& old_stmt,
-        const QoreProgramLocation*& old_loc) {
+        const QoreProgramLocation*& old_loc, int64& old_po) {
     ThreadData* td = thread_data.get();
     old_stmt = td->runtime_statement;
     old_loc = td->runtime_loc;
+    old_po = td->runtime_po;
+    // keep the current parse options when there is no current statement
+    td->runtime_po = td->getRuntimeParseOptions();
     td->runtime_statement = nullptr;
     td->runtime_loc = loc;
 }
@@ -2301,7 +2530,24 @@ int64 parse_get_parse_options() {
 }
 
 int64 runtime_get_parse_options() {
-    return (thread_data.get())->runtime_po;
+    return (thread_data.get())->getRuntimeParseOptions();
+}
+
+QoreListNode* get_thread_eval_list() {
+    ThreadData* td = thread_data.get();
+    if (td && td->eval_list_cache_count) {
+        return td->eval_list_cache[--td->eval_list_cache_count];
+    }
+    return nullptr;
+}
+
+bool put_thread_eval_list(QoreListNode* l) {
+    ThreadData* td = thread_data.get();
+    if (td && td->eval_list_cache_count < QORE_THREAD_EVAL_LIST_CACHE) {
+        td->eval_list_cache[td->eval_list_cache_count++] = l;
+        return true;
+    }
+    return false;
 }
 
 bool parse_check_parse_option(int64 o) {
@@ -2511,7 +2757,7 @@ int q_reserve_foreign_thread_id() {
 }
 
 int q_release_reserved_foreign_thread_id(int tid) {
-    if (tid < 0 || tid >= MAX_QORE_THREADS) {
+    if (tid < 0 || tid >= QORE_THREAD_LIMIT_MAX) {
         return -1;
     }
 
@@ -2520,7 +2766,7 @@ int q_release_reserved_foreign_thread_id(int tid) {
 }
 
 int q_register_reserved_foreign_thread(int tid) {
-    if (tid < 0 || tid >= MAX_QORE_THREADS) {
+    if (tid < 0 || tid >= QORE_THREAD_LIMIT_MAX) {
         return -1;
     }
 
@@ -2663,81 +2909,99 @@ namespace {
         return 0;
     }
 
-    extern "C" void* op_background_thread(void* x) {
-        BGThreadParams* btp = (BGThreadParams*)x;
+    // executes a background expression in the current thread
+    void run_background_thread(BGThreadParams* btp, bool reused) {
         // register thread
         register_thread(btp->tid, pthread_self(), btp->pgm);
-        printd(5, "op_background_thread() btp: %p TID %d started\n", btp, btp->tid);
+        printd(5, "op_background_thread() btp: %p TID %d started (reused: %d)\n", btp, btp->tid, reused);
+        if (reused) {
+            // the thread was already detached when its first TID was released
+            thread_list.setDetached(btp->tid);
+        }
 
         set_tid_thread_name(btp->tid);
 
-        pthread_cleanup_push(qore_thread_cleanup, nullptr);
+        ExceptionSink xsink;
 
-        {
-            ExceptionSink xsink;
+        // register thread in Program object
+        btp->startThread(xsink);
 
-            // register thread in Program object
-            btp->startThread(xsink);
+        {
+            QoreValue rv;
+            ThreadData* td = thread_data.get();
 
             {
-                QoreValue rv;
-                ThreadData* td = thread_data.get();
+                CodeContextHelper cch(&xsink, CT_NEWTHREAD, "background operator",
+                    btp->getContextObject(), btp->class_ctx);
+                QoreInternalCallStackLocationHelper stack_loc(*btp->loc, "<background operator>", CT_NEWTHREAD);
+                // save runtime location of thread creation call
+                td->runtime_loc = btp->loc;
+
+                // dereference call object if present
+                btp->derefCallObj();
 
-                {
-                    CodeContextHelper cch(&xsink, CT_NEWTHREAD, "background operator",
-                        btp->getContextObject(), btp->class_ctx);
-                    QoreInternalCallStackLocationHelper stack_loc(*btp->loc, "<background operator>", CT_NEWTHREAD);
-                    // save runtime location of thread creation call
-                    td->runtime_loc = btp->loc;
-
-                    // dereference call object if present
-                    btp->derefCallObj();
-
-                    ThreadLocalProgramData* tlpd = get_thread_local_program_data();
-                    if (tlpd) {
-                        tlpd->dbgAttach(&xsink);
-                    }
-                    // run thread expression
-                    rv = btp->exec(&xsink);
-                    if (tlpd) {
-                        // notify return value and notify thread detach to program
-                        tlpd->dbgExit(nullptr, rv, &xsink);
-                        tlpd->dbgDetach(&xsink);
-                    }
-
-                    // if there is an object, we dereference the extra reference here
-                    btp->derefObj(&xsink);
+                ThreadLocalProgramData* tlpd = get_thread_local_program_data();
+                if (tlpd) {
+                    tlpd->dbgAttach(&xsink);
+                }
+                // run thread expression
+                rv = btp->exec(&xsink);
+                if (tlpd) {
+                    // notify return value and notify thread detach to program
+                    tlpd->dbgExit(nullptr, rv, &xsink);
+                    tlpd->dbgDetach(&xsink);
                 }
 
-                // dereference any return value from the background expression
-                rv.discard(&xsink);
+                // if there is an object, we dereference the extra reference here
+                btp->derefObj(&xsink);
+            }
 
-                // cleanup thread resources
-                purge_thread_resources(&xsink);
+            // dereference any return value from the background expression
+            rv.discard(&xsink);
 
-                int tid = btp->tid;
-                // dereference current Program object
-                btp->del();
+            // cleanup thread resources
+            purge_thread_resources(&xsink);
 
-                assert(xsink.isException() || !td->active_exceptions);
+            int tid = btp->tid;
+            // dereference current Program object
+            btp->del();
 
-                // delete any thread data
-                td->del(&xsink);
+            assert(xsink.isException() || !td->active_exceptions);
 
-                xsink.handleExceptions();
+            // delete any thread data
+            td->del(&xsink);
 
-                printd(4, "thread terminating");
+            xsink.handleExceptions();
 
-                // run any cleanup functions
-                tclist.exec();
+            printd(4, "thread terminating");
 
-                // delete internal thread data structure and release TID entry
-                thread_list.deleteDataRelease(tid);
-            }
+            // run any cleanup functions
+            tclist.exec();
+
+            // delete internal thread data structure and release TID entry
+            thread_list.deleteDataRelease(tid);
+        }
+    }
+
+    extern "C" void* op_background_thread(void* x) {
+        BGThreadParams* btp = (BGThreadParams*)x;
+
+        pthread_cleanup_push(qore_thread_cleanup, nullptr);
+
+        bool reused = false;
+        while (btp) {
+            run_background_thread(btp, reused);
+            // register the thread with the pool before it leaves the thread counter so that library shutdown
+            // always waits for it
+            bg_thread_pool.enter();
+            thread_counter.dec();
+            // park the thread for reuse if the thread pool is enabled
+            btp = bg_thread_pool.park();
+            reused = true;
         }
 
         pthread_cleanup_pop(1);
-        thread_counter.dec();
+        bg_thread_pool.exitThread();
         pthread_exit(0);
         return 0;
     }
@@ -2762,7 +3026,8 @@ QoreValue do_op_background(const QoreValue left, ExceptionSink* xsink) {
 
     // if can't start thread, then throw exception
     if (tid == -1) {
-        xsink->raiseException("THREAD-CREATION-FAILURE", "thread list is full with %d threads", MAX_QORE_THREADS);
+        xsink->raiseException("THREAD-CREATION-FAILURE", "thread list is full with %d threads",
+            thread_list.getThreadLimit());
         return QoreValue();
     }
 
@@ -2780,6 +3045,11 @@ QoreValue do_op_background(const QoreValue left, ExceptionSink* xsink) {
     //printd(5, "calling pthread_create(%p, %p, %p, %p)\n", &ptid, &ta_default, op_background_thread, tp);
     thread_counter.inc();
 
+    // reuse a parked thread if possible
+    if (q_background_thread_pool && bg_thread_pool.dispatch(tp)) {
+        return tid;
+    }
+
 #ifdef QORE_MANAGE_STACK
     // make sure accesses to ta_default are made locked
     AutoLocker al(stack_lck);
@@ -2794,6 +3064,7 @@ QoreValue do_op_background(const QoreValue left, ExceptionSink* xsink) {
         xsink->raiseErrnoException("THREAD-CREATION-FAILURE", rc, "could not create thread");
         return QoreValue();
     }
+    qore_bg_threads_created.fetch_add(1, std::memory_order_relaxed);
     //printd(5, "pthread_create() new thread TID %d, pthread_create() returned %d\n", tid, rc);
     return tid;
 }
@@ -2804,7 +3075,8 @@ int q_start_thread(ExceptionSink* xsink, q_thread_t f, void* arg) {
 
     // if can't start thread, then throw exception
     if (tid == -1) {
-        xsink->raiseException("THREAD-CREATION-FAILURE", "thread list is full with %d threads", MAX_QORE_THREADS);
+        xsink->raiseException("THREAD-CREATION-FAILURE", "thread list is full with %d threads",
+            thread_list.getThreadLimit());
         return -1;
     }
 
@@ -2864,6 +3136,9 @@ size_t q_thread_set_stack_size(size_t size, ExceptionSink* xsink) {
     // make sure we check what was actually set
     qore_thread_stack_size = ta_default.getstacksize();
 
+    // parked threads have the old stack size
+    bg_thread_pool.flush();
+
     return qore_thread_stack_size;
 }
 
@@ -3001,6 +3276,7 @@ QoreNamespace* get_thread_ns(QoreNamespace &qorens) {
     Thread->addSystemClass(initAutoReadLockClass(*Thread));
     Thread->addSystemClass(initAutoWriteLockClass(*Thread));
 
+    Thread->addSystemClass(initThreadPoolFutureClass(*Thread));
     Thread->addSystemClass(initThreadPoolClass(*Thread));
 
     Thread->addSystemClass(initAbstractThreadResourceClass(*Thread));
@@ -3025,6 +3301,9 @@ void delete_thread_local_data() {
 void delete_qore_threads() {
     QORE_TRACE("delete_qore_threads()");
 
+    // make any parked background threads exit
+    bg_thread_pool.shutdown();
+
     // mark threading as inactive
     threads_initialized = false;
 
@@ -3082,7 +3361,7 @@ QoreHashNode* QoreThreadList::getAllCallStacks() {
     QoreThreadListIterator i(true);
     while (i.next()) {
         // get call stack
-        ThreadData* td = entry[*i].thread_data;
+        ThreadData* td = entry(*i).thread_data;
         if (td && td->current_stack_location) {
             ReferenceHolder<QoreListNode> stack(getCallStack(td->current_stack_location), nullptr);
             if (!stack->empty()) {
@@ -3187,12 +3466,37 @@ QoreHashNode* QoreThreadList::getCallStackHash(const QoreStackLocation& stack_lo
     return h.release();
 }
 
+int64 QoreThreadList::getStat(qore_thread_stat_e stat) const {
+    int64 rv = 0;
+    AutoLocker al(lck);
+    for (const ThreadEntry* c : entry_chunks) {
+        if (!c) {
+            continue;
+        }
+        for (unsigned i = 0; i < QORE_THREAD_ENTRY_CHUNK; ++i) {
+            rv += c[i].stats[stat].load(std::memory_order_relaxed);
+        }
+    }
+    return rv;
+}
+
+void q_inc_thread_stat(qore_thread_stat_e stat) {
+    ThreadData* td = thread_data.get();
+    if (td) {
+        thread_list.incStat(td->tid, stat);
+    }
+}
+
+int64 q_get_thread_stat(qore_thread_stat_e stat) {
+    return thread_list.getStat(stat);
+}
+
 void QoreThreadList::deleteData(int tid) {
     delete thread_data.get();
     thread_data.set(nullptr);
 
     AutoLocker al(lck);
-    entry[tid].thread_data = nullptr;
+    entry(tid).thread_data = nullptr;
 }
 
 void QoreThreadList::deleteDataRelease(int tid) {
@@ -3200,7 +3504,7 @@ void QoreThreadList::deleteDataRelease(int tid) {
     thread_data.set(nullptr);
 
     AutoLocker al(lck);
-    entry[tid].thread_data = nullptr;
+    entry(tid).thread_data = nullptr;
 
     releaseIntern(tid);
 }
@@ -3223,13 +3527,13 @@ unsigned QoreThreadList::cancelAllActiveThreads() {
 
     while (i.next()) {
         if (*i != (unsigned)tid) {
-            //printf("QoreThreadList::cancelAllActiveThreads() canceling TID %d ptid: %p (this TID: %d)\n", *i, entry[*i].ptid, tid);
-            int trc = pthread_cancel(entry[*i].ptid);
+            //printf("QoreThreadList::cancelAllActiveThreads() canceling TID %d ptid: %p (this TID: %d)\n", *i, entry(*i).ptid, tid);
+            int trc = pthread_cancel(entry(*i).ptid);
             if (!trc) {
                 ++tcc;
 #ifdef DEBUG
             } else {
-                printd(0, "pthread_cancel() returned %d (%s) on tid %d (%p)\n", trc, strerror(trc), tid, entry[*i].ptid);
+                printd(0, "pthread_cancel() returned %d (%s) on tid %d (%p)\n", trc, strerror(trc), tid, entry(*i).ptid);
 #endif
             }
         }